@@ -0,0 +1,330 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Aho-Corasick automaton for searching many patterns at once. Unlike the
+// Rabin-Karp matcher in karp_rabin.cpp, which probes one fingerprint table
+// per distinct pattern length at every text position, the automaton makes
+// one transition per text byte and then walks only the outputs that
+// actually end there, so a search costs O(n + matches) however many
+// patterns there are.
+
+// Called for every occurrence found: the index of the pattern that matched
+// and the offset in the text where the occurrence starts. Same as in
+// karp_rabin.cpp, so callbacks can be shared between the two.
+typedef void (*MatchCallback)(int pattern, long long position, void *context);
+
+// States are numbered in breadth-first order, so the root is 0 and shallow
+// states, which a search visits most, have the smallest numbers. The first
+// DENSE_STATES of them get a full 256-entry transition row with failure
+// transitions already folded in: one load per byte, no branching. Deeper
+// states keep only their real edges, sorted by label in two flat arrays, and
+// fall back along failure links when a byte has no edge. Their rows are
+// short and stored back to back, so a deep walk stays within a few cache
+// lines instead of dragging in a mostly empty 1 KB row per state.
+const int DENSE_STATES = 256;
+
+struct Automaton {
+    std::vector<std::string> patterns;
+    int stateCount;
+    int denseCount;                 // States 0 .. denseCount-1 have a dense row.
+    std::vector<int> dense;         // dense[s * 256 + c]: next state from s on byte c.
+    std::vector<int> edgeStart;     // Edges of state s are edgeStart[s] .. edgeStart[s+1]-1.
+    std::vector<unsigned char> edgeLabel;
+    std::vector<int> edgeTarget;
+    std::vector<int> fail;          // Longest proper suffix of s that is also a state.
+    std::vector<int> output;        // First pattern ending exactly at s, or -1.
+    std::vector<int> nextOutput;    // Next pattern equal to pattern i, or -1.
+    std::vector<int> outputLink;    // Nearest state on s's failure chain with an output, or -1.
+    std::vector<int> depth;         // Length of the string spelled by s.
+};
+
+// Target of s's edge on byte c, or -1 if s has none. Edge lists are sorted
+// and usually short, so a linear scan beats a binary search.
+inline int findEdge(const Automaton* ac, int s, unsigned char c) {
+    for (int e = ac->edgeStart[s]; e < ac->edgeStart[s + 1]; e++) {
+        if (ac->edgeLabel[e] >= c) {
+            return ac->edgeLabel[e] == c ? ac->edgeTarget[e] : -1;
+        }
+    }
+    return -1;
+}
+
+// Full transition function: the state reached from s by reading byte c.
+inline int step(const Automaton* ac, int s, unsigned char c) {
+    while (s >= ac->denseCount) {
+        int next = findEdge(ac, s, c);
+        if (next != -1) {
+            return next;
+        }
+        s = ac->fail[s];
+    }
+    return ac->dense[s * 256 + c];
+}
+
+// Build the automaton for a list of patterns. Empty patterns are kept (so
+// pattern indices match the input) but never reported.
+Automaton* buildAutomaton(const std::vector<std::string> &patterns) {
+    // Plain trie first, with children in sorted maps of (label, child).
+    std::vector<std::vector<std::pair<unsigned char, int> > > children(1);
+    std::vector<int> trieOutput(1, -1);
+    std::vector<int> nextOutput(patterns.size(), -1);
+    for (int i = 0; i < (int)patterns.size(); i++) {
+        if (patterns[i].empty()) {
+            continue;
+        }
+        int s = 0;
+        for (char ch : patterns[i]) {
+            unsigned char c = ch;
+            auto &kids = children[s];
+            auto it = std::lower_bound(kids.begin(), kids.end(), std::make_pair(c, 0));
+            if (it != kids.end() && it->first == c) {
+                s = it->second;
+            } else {
+                int child = children.size();
+                kids.insert(it, std::make_pair(c, child));
+                children.emplace_back();
+                trieOutput.push_back(-1);
+                s = child;
+            }
+        }
+        nextOutput[i] = trieOutput[s];
+        trieOutput[s] = i;
+    }
+
+    // Renumber the states breadth-first.
+    int stateCount = children.size();
+    std::vector<int> order(1, 0);       // order[new] = old
+    std::vector<int> renumber(stateCount);
+    renumber[0] = 0;
+    for (int i = 0; i < (int)order.size(); i++) {
+        for (auto &kid : children[order[i]]) {
+            renumber[kid.second] = order.size();
+            order.push_back(kid.second);
+        }
+    }
+
+    Automaton* ac = new Automaton;
+    ac->patterns = patterns;
+    ac->stateCount = stateCount;
+    ac->denseCount = std::min(stateCount, DENSE_STATES);
+    ac->dense.assign((size_t)ac->denseCount * 256, 0);
+    ac->edgeStart.assign(stateCount + 1, 0);
+    ac->fail.assign(stateCount, 0);
+    ac->output.resize(stateCount);
+    ac->nextOutput = nextOutput;
+    ac->outputLink.assign(stateCount, -1);
+    ac->depth.assign(stateCount, 0);
+    for (int s = 0; s < stateCount; s++) {
+        const auto &kids = children[order[s]];
+        ac->output[s] = trieOutput[order[s]];
+        ac->edgeStart[s + 1] = ac->edgeStart[s] + kids.size();
+        for (auto &kid : kids) {
+            ac->edgeLabel.push_back(kid.first);
+            ac->edgeTarget.push_back(renumber[kid.second]);
+        }
+    }
+
+    // Failure links and dense rows, again breadth-first. Everything step()
+    // needs for a state of depth d, the failure links and dense rows of
+    // shallower states, is ready by the time that state is reached.
+    for (int s = 0; s < stateCount; s++) {
+        for (int e = ac->edgeStart[s]; e < ac->edgeStart[s + 1]; e++) {
+            int child = ac->edgeTarget[e];
+            int f = (s == 0) ? 0 : step(ac, ac->fail[s], ac->edgeLabel[e]);
+            ac->fail[child] = f;
+            ac->outputLink[child] = (ac->output[f] != -1) ? f : ac->outputLink[f];
+            ac->depth[child] = ac->depth[s] + 1;
+        }
+        if (s < ac->denseCount) {
+            int *row = &ac->dense[(size_t)s * 256];
+            for (int c = 0; c < 256; c++) {
+                int next = findEdge(ac, s, c);
+                row[c] = (next != -1) ? next : (s == 0 ? 0 : step(ac, ac->fail[s], c));
+            }
+        }
+    }
+    return ac;
+}
+
+// Feed text[0..n), whose first byte is at stream offset `offset`, to the
+// automaton starting in state s. Reports every occurrence ending in this
+// piece of text and returns the state to continue from, so a stream can be
+// searched a block at a time.
+int scanText(const Automaton* ac, int s, const char *text, long long n, long long offset,
+             MatchCallback onMatch, void *context) {
+    for (long long i = 0; i < n; i++) {
+        s = step(ac, s, text[i]);
+        for (int t = (ac->output[s] != -1) ? s : ac->outputLink[s]; t != -1; t = ac->outputLink[t]) {
+            long long start = offset + i + 1 - ac->depth[t];
+            for (int p = ac->output[t]; p != -1; p = ac->nextOutput[p]) {
+                onMatch(p, start, context);
+            }
+        }
+    }
+    return s;
+}
+
+// Report every occurrence of every pattern in text[0..n). Occurrences come
+// out in order of their end position, longest pattern first.
+void searchPatterns(const Automaton* ac, const char *text, long long n,
+                    MatchCallback onMatch, void *context) {
+    scanText(ac, 0, text, n, 0, onMatch, context);
+}
+
+const size_t STREAM_CHUNK = 1 << 20;
+
+// Search everything read from fd until end of file. The automaton state is
+// all that has to survive from one chunk to the next. Returns false on a
+// read error; matches reported up to that point stand.
+bool searchFd(const Automaton* ac, int fd, MatchCallback onMatch, void *context) {
+    std::vector<char> buffer(STREAM_CHUNK);
+    long long offset = 0;
+    int s = 0;
+    while (true) {
+        ssize_t got = read(fd, buffer.data(), STREAM_CHUNK);
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        if (got == 0) {
+            return true;
+        }
+        s = scanText(ac, s, buffer.data(), got, offset, onMatch, context);
+        offset += got;
+    }
+}
+
+void deleteAutomaton(Automaton* ac) {
+    delete ac;
+}
+
+bool readFile(const char *path, std::string *contents) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    *contents = buffer.str();
+    return true;
+}
+
+// Read one pattern per line.
+bool readPatterns(const char *path, std::vector<std::string> *patterns) {
+    std::string patternText;
+    if (!readFile(path, &patternText)) {
+        return false;
+    }
+    std::istringstream lines(patternText);
+    std::string line;
+    while (getline(lines, line)) {
+        patterns->push_back(line);
+    }
+    return true;
+}
+
+void collectPosition(int pattern, long long position, void *context) {
+    (*(std::vector<std::vector<long long> > *)context)[pattern].push_back(position);
+}
+
+void printMatch(int pattern, long long position, void *context) {
+    const Automaton* ac = (const Automaton*)context;
+    cout << position << "\t" << ac->patterns[pattern] << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    // "multi PATTERN_FILE TEXT_FILE" finds every line of PATTERN_FILE in
+    // TEXT_FILE and prints "offset<TAB>pattern" per match, like karp_rabin.
+    if (argc > 3 && string(argv[1]) == "multi") {
+        std::vector<std::string> patterns;
+        std::string text;
+        if (!readPatterns(argv[2], &patterns) || !readFile(argv[3], &text)) {
+            cout << "Could not read input files." << endl;
+            return 1;
+        }
+
+        auto build = chrono::steady_clock::now();
+        Automaton* ac = buildAutomaton(patterns);
+        auto start = chrono::steady_clock::now();
+        searchPatterns(ac, text.data(), text.size(), printMatch, ac);
+        auto stop = chrono::steady_clock::now();
+        cerr << patterns.size() << " patterns, " << ac->stateCount << " states built in "
+             << chrono::duration<double>(start - build).count() << " s, " << text.size()
+             << " bytes scanned in " << chrono::duration<double>(stop - start).count() << " s"
+             << endl;
+        deleteAutomaton(ac);
+        return 0;
+    }
+    // "stream PATTERN_FILE [FILE]" does the same without loading the text:
+    // FILE (or stdin if absent or "-") is read in fixed-size chunks.
+    if (argc > 2 && string(argv[1]) == "stream") {
+        std::vector<std::string> patterns;
+        if (!readPatterns(argv[2], &patterns)) {
+            cout << "Could not read pattern file " << argv[2] << endl;
+            return 1;
+        }
+        Automaton* ac = buildAutomaton(patterns);
+        bool fromStdin = argc < 4 || string(argv[3]) == "-";
+        int fd = fromStdin ? 0 : open(argv[3], O_RDONLY);
+        bool ok = fd >= 0 && searchFd(ac, fd, printMatch, ac);
+        if (fd > 0) {
+            close(fd);
+        }
+        deleteAutomaton(ac);
+        if (!ok) {
+            cout << "Could not read " << (fromStdin ? "standard input" : argv[3]) << endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // Read the patterns and the text
+    int n;
+    cout << "Enter number of patterns: ";
+    cin >> n;
+    cin.ignore();
+    std::vector<std::string> patterns(n);
+    for (int i = 0; i < n; i++) {
+        cout << "Enter pattern " << i + 1 << ": ";
+        getline(cin, patterns[i]);
+    }
+    string text;
+    cout << "Enter text: ";
+    getline(cin, text);
+
+    // Collect the occurrences, then list them per pattern.
+    Automaton* ac = buildAutomaton(patterns);
+    std::vector<std::vector<long long> > occ(n);
+    searchPatterns(ac, text.data(), text.size(), collectPosition, &occ);
+
+    // Output the results
+    for (int i = 0; i < n; i++) {
+        cout << "Pattern \"" << patterns[i] << "\": ";
+        if (occ[i].empty()) {
+            cout << "not found." << endl;
+            continue;
+        }
+        cout << "found at indices: ";
+        std::sort(occ[i].begin(), occ[i].end());
+        for (long long position : occ[i]) {
+            cout << position << " ";
+        }
+        cout << endl;
+    }
+
+    deleteAutomaton(ac);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,191 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include "string_hash.h"
+
+using namespace std;
+using namespace chained;
+
+// Concurrent string set built from the chained HashTable in string_hash.h.
+//
+// Keys are spread over 2^SHARD_BITS shards by the top bits of their hash,
+// and each shard is an ordinary chained table plus a mutex. Writers lock
+// only their shard. Readers take no lock at all: a new node is filled in
+// completely and then published by a release store of the bucket head, and
+// nodes are never unlinked or freed while the map is live, so a reader that
+// loads the head with acquire ordering always walks a consistent chain.
+
+const int SHARD_BITS = 6;
+const int SHARD_COUNT = 1 << SHARD_BITS;
+
+// One shard per cache line pair so writers on different shards do not
+// bounce the same line between cores.
+struct alignas(128) Shard {
+    HashTable* table;
+    std::mutex writeLock;   // Serializes inserts; searches never take it.
+};
+
+struct ConcurrentHashTable {
+    Shard shards[SHARD_COUNT];
+    HashFunction hash;
+};
+
+// Create a concurrent table with bucketsPerShard chains in every shard.
+// The shard is picked from the top hash bits, so the hash function must
+// fill all 64 bits (mixHash or crc32cHash, not polynomialHash).
+ConcurrentHashTable* createConcurrentHashTable(int bucketsPerShard, HashFunction hash = mixHash) {
+    ConcurrentHashTable* cht = new ConcurrentHashTable;
+    cht->hash = hash;
+    for (int s = 0; s < SHARD_COUNT; s++) {
+        cht->shards[s].table = createHashTable(bucketsPerShard, hash);
+    }
+    return cht;
+}
+
+Shard* shardFor(ConcurrentHashTable* cht, unsigned long long hash_val) {
+    return &cht->shards[hash_val >> (64 - SHARD_BITS)];
+}
+
+// Walk one chain; safe to run while another thread inserts into it.
+bool findInChain(HashTable* ht, const std::string &key, unsigned long long hash_val) {
+    int index = hash_val % ht->size;
+    Node* current = __atomic_load_n(&ht->buckets[index], __ATOMIC_ACQUIRE);
+    while (current != nullptr) {
+        if (nodeMatches(current, key, hash_val)) {
+            return true;
+        }
+        current = current->next;
+    }
+    return false;
+}
+
+// Insert a key; returns false if it was already present.
+bool concurrentInsert(ConcurrentHashTable* cht, const std::string &key) {
+    unsigned long long hash_val = cht->hash(key);
+    Shard* shard = shardFor(cht, hash_val);
+    HashTable* ht = shard->table;
+
+    std::lock_guard<std::mutex> guard(shard->writeLock);
+    if (findInChain(ht, key, hash_val)) {
+        return false;
+    }
+    int index = hash_val % ht->size;
+    Node* newNode = makeNode(ht, key, hash_val);
+    newNode->next = ht->buckets[index];
+    // Publish the fully built node to lock-free readers.
+    __atomic_store_n(&ht->buckets[index], newNode, __ATOMIC_RELEASE);
+    return true;
+}
+
+// Lock-free search; returns true if the key is present.
+bool concurrentSearch(ConcurrentHashTable* cht, const std::string &key) {
+    unsigned long long hash_val = cht->hash(key);
+    return findInChain(shardFor(cht, hash_val)->table, key, hash_val);
+}
+
+// Free the table. No other thread may be using it.
+void deleteConcurrentHashTable(ConcurrentHashTable* cht) {
+    for (int s = 0; s < SHARD_COUNT; s++) {
+        deleteHashTable(cht->shards[s].table);
+    }
+    delete cht;
+}
+
+// ---------------- Benchmark ----------------
+
+// The baseline the sharded table replaces: one table behind one mutex.
+struct LockedHashTable {
+    HashTable* table;
+    std::mutex lock;
+};
+
+const int PRELOADED_KEYS = 1 << 20;
+const int OPS_PER_THREAD = 1 << 16;
+const int INSERT_PERCENT = 10;
+
+// Each thread runs OPS_PER_THREAD operations: INSERT_PERCENT inserts of new
+// keys, the rest searches of preloaded keys. Returns total ops/sec.
+// The number of successful operations is added to *hits so that the
+// compiler cannot drop searches whose result is otherwise unused.
+template <typename Op>
+double runThreads(int threads, const vector<vector<string>> &workload, long long *hits, Op op) {
+    vector<thread> workers;
+    vector<long long> threadHits(threads, 0);
+    auto start = chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            const vector<string> &keys = workload[t];
+            long long local = 0;
+            for (int i = 0; i < OPS_PER_THREAD; i++) {
+                local += op(i % 100 < INSERT_PERCENT, keys[i]);
+            }
+            threadHits[t] = local;
+        });
+    }
+    for (thread &worker : workers) {
+        worker.join();
+    }
+    auto stop = chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++) {
+        *hits += threadHits[t];
+    }
+    return (double)threads * OPS_PER_THREAD / chrono::duration<double>(stop - start).count();
+}
+
+int main() {
+    const int threadCounts[] = {1, 2, 4, 8, 16, 32, 64};
+    const int maxThreads = 64;
+
+    // Per-thread operation keys, built up front so only table work is timed.
+    // Insert slots get keys unique to the thread; search slots hit preloaded keys.
+    vector<vector<string>> workload(maxThreads);
+    for (int t = 0; t < maxThreads; t++) {
+        workload[t].resize(OPS_PER_THREAD);
+        for (int i = 0; i < OPS_PER_THREAD; i++) {
+            if (i % 100 < INSERT_PERCENT) {
+                workload[t][i] = "new-" + to_string(t) + "-" + to_string(i);
+            } else {
+                workload[t][i] = "key-" + to_string((i * 2654435761u + t) % PRELOADED_KEYS);
+            }
+        }
+    }
+
+    cout << "threads\tsharded Mops/s\tsingle-mutex Mops/s" << endl;
+    for (int threads : threadCounts) {
+        ConcurrentHashTable* cht = createConcurrentHashTable(PRELOADED_KEYS / SHARD_COUNT);
+        LockedHashTable locked;
+        locked.table = createHashTable(PRELOADED_KEYS, mixHash);
+        for (int i = 0; i < PRELOADED_KEYS; i++) {
+            string key = "key-" + to_string(i);
+            concurrentInsert(cht, key);
+            insert(locked.table, key);
+        }
+
+        long long hits = 0;
+        double sharded = runThreads(threads, workload, &hits, [&](bool isInsert, const string &key) {
+            if (isInsert) {
+                return concurrentInsert(cht, key);
+            }
+            return concurrentSearch(cht, key);
+        });
+        double single = runThreads(threads, workload, &hits, [&](bool isInsert, const string &key) {
+            std::lock_guard<std::mutex> guard(locked.lock);
+            if (isInsert) {
+                insert(locked.table, key);
+                return true;
+            }
+            return search(locked.table, key);
+        });
+        if (hits != 2LL * threads * OPS_PER_THREAD) {
+            cout << "unexpected miss at " << threads << " threads" << endl;
+        }
+        cout << threads << "\t" << sharded / 1e6 << "\t" << single / 1e6 << endl;
+
+        deleteConcurrentHashTable(cht);
+        deleteHashTable(locked.table);
+    }
+    return 0;
+}
\ No newline at end of file
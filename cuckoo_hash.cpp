@@ -0,0 +1,343 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include "hash_functions.h"
+#include "key_arena.h"
+
+using namespace std;
+
+// Bucketized cuckoo hash table.
+//
+// Every key has exactly two candidate buckets of BUCKET_SLOTS slots each, so
+// a search inspects at most two buckets no matter how full the table is. A
+// bucket is one 64-byte cache line holding a 32-bit tag and an 8-byte KeyRef
+// per slot. Keys themselves live in a KeyArena (key_arena.h). A lookup reads
+// at most the two bucket lines and then only the keys whose tag matches; a
+// false tag match is about 1 in 2 billion per slot.
+//
+// Both buckets come from one hash: the first is taken from its low bits and
+// the second is the first XOR a scramble of the tag. The same XOR turns
+// either bucket into the other, so an evicted key can be moved without
+// reading its characters or rehashing it.
+//
+// An insert into two full buckets evicts a random resident to that key's
+// other bucket, repeating up to MAX_KICKS times. Only then does the table
+// double. With 4-way buckets that happens at about 95% load.
+
+const int BUCKET_SLOTS = 4;
+const int INITIAL_BUCKETS = 16;
+const int MAX_KICKS = 500;
+
+// Erased keys leave their characters behind in the arena. Once those dead
+// bytes outweigh the live ones, the table is rebuilt at the same size.
+const uint64_t COMPACT_MIN_BYTES = 1 << 16;
+
+struct alignas(64) Bucket {
+    uint32_t tags[BUCKET_SLOTS];    // 0 marks an empty slot.
+    KeyRef keys[BUCKET_SLOTS];
+};
+
+struct CuckooHashTable {
+    Bucket *buckets;
+    uint64_t bucketMask;    // Bucket count minus one; the count is a power of two.
+    int count;              // Number of distinct keys stored.
+    HashFunction hash;      // Chosen when the table is created.
+    KeyArena arena;
+    uint64_t liveBytes;     // Bytes of `arena` still referenced by a slot.
+    ull rng;                // State for picking eviction victims.
+};
+
+// Spread the hash over all 64 bits; polynomialHash only fills the low 30.
+ull spreadHash(ull hash_val) {
+    return multiplyMix(hash_val, MIX_SECRET1);
+}
+
+uint32_t tagOf(ull spread) {
+    return (uint32_t)(spread >> 32) | 1;
+}
+
+uint64_t firstBucket(const CuckooHashTable* ht, ull spread) {
+    return spread & ht->bucketMask;
+}
+
+// The other candidate bucket of a key with this tag that sits in `bucket`.
+uint64_t altBucket(const CuckooHashTable* ht, uint64_t bucket, uint32_t tag) {
+    return (bucket ^ ((ull)tag * 0xc6a4a7935bd1e995ULL >> 32)) & ht->bucketMask;
+}
+
+Bucket* allocateBuckets(uint64_t count) {
+    Bucket *buckets = new Bucket[count];
+    for (uint64_t b = 0; b < count; b++) {
+        for (int s = 0; s < BUCKET_SLOTS; s++) {
+            buckets[b].tags[s] = 0;
+            buckets[b].keys[s] = EMPTY_REF;
+        }
+    }
+    return buckets;
+}
+
+// Create a table with room for at least `size` keys before its first growth.
+CuckooHashTable* createCuckooHashTable(int size, HashFunction hash = polynomialHash) {
+    uint64_t bucketCount = INITIAL_BUCKETS;
+    while (bucketCount * BUCKET_SLOTS < (uint64_t)size) {
+        bucketCount *= 2;
+    }
+    CuckooHashTable* ht = new CuckooHashTable;
+    ht->buckets = allocateBuckets(bucketCount);
+    ht->bucketMask = bucketCount - 1;
+    ht->count = 0;
+    ht->hash = hash;
+    initArena(&ht->arena);
+    ht->liveBytes = 0;
+    ht->rng = MIX_SECRET2;
+    return ht;
+}
+
+// Slot of key in bucket, or -1. Characters are compared only on a tag match.
+int findInBucket(const CuckooHashTable* ht, const Bucket *bucket, uint32_t tag,
+                 const std::string &key, ull hash_val) {
+    for (int s = 0; s < BUCKET_SLOTS; s++) {
+        if (bucket->tags[s] == tag && keyEquals(&ht->arena, bucket->keys[s], key, hash_val)) {
+            return s;
+        }
+    }
+    return -1;
+}
+
+// Put an entry into a free slot of bucket; returns false if it is full.
+bool placeInBucket(Bucket *bucket, uint32_t tag, KeyRef key) {
+    for (int s = 0; s < BUCKET_SLOTS; s++) {
+        if (bucket->tags[s] == 0) {
+            bucket->tags[s] = tag;
+            bucket->keys[s] = key;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Place an absent entry whose first bucket is `bucket`, evicting residents
+// along a random walk if both candidate buckets are full. Returns false if
+// the walk gave up; *tag and *key then hold the entry still left homeless,
+// which may be a different one from the entry passed in.
+bool placeEntry(CuckooHashTable* ht, uint64_t bucket, uint32_t *tag, KeyRef *key) {
+    if (placeInBucket(&ht->buckets[bucket], *tag, *key)) {
+        return true;
+    }
+    bucket = altBucket(ht, bucket, *tag);
+    for (int kick = 0; kick < MAX_KICKS; kick++) {
+        if (placeInBucket(&ht->buckets[bucket], *tag, *key)) {
+            return true;
+        }
+        // Swap with a random resident and send it to its other bucket.
+        ht->rng = ht->rng * 6364136223846793005ULL + 1442695040888963407ULL;
+        int victim = (ht->rng >> 32) % BUCKET_SLOTS;
+        std::swap(ht->buckets[bucket].tags[victim], *tag);
+        std::swap(ht->buckets[bucket].keys[victim], *key);
+        bucket = altBucket(ht, bucket, *tag);
+    }
+    return false;
+}
+
+// Rebuild the table with newBucketCount buckets and a fresh arena holding
+// only the live keys, then place the extra entry `pending` (if any) whose
+// characters are still in the old arena. Doubles again if a walk fails.
+void rebuild(CuckooHashTable* ht, uint64_t newBucketCount, const uint32_t *pendingTag, const KeyRef *pending) {
+    Bucket *oldBuckets = ht->buckets;
+    uint64_t oldCount = ht->bucketMask + 1;
+    KeyArena oldArena = ht->arena;
+
+    while (true) {
+        ht->buckets = allocateBuckets(newBucketCount);
+        ht->bucketMask = newBucketCount - 1;
+        initArena(&ht->arena);
+        ht->liveBytes = 0;
+
+        bool placed = true;
+        for (uint64_t b = 0; b <= oldCount && placed; b++) {
+            for (int s = 0; s < BUCKET_SLOTS && placed; s++) {
+                uint32_t tag;
+                KeyRef key;
+                if (b < oldCount) {
+                    tag = oldBuckets[b].tags[s];
+                    key = oldBuckets[b].keys[s];
+                } else if (s == 0 && pending != nullptr) {
+                    tag = *pendingTag;
+                    key = *pending;
+                } else {
+                    continue;
+                }
+                if (tag == 0) {
+                    continue;
+                }
+                ull hash_val = arenaHash(&oldArena, key);
+                KeyRef copy = arenaAppend(&ht->arena, arenaKey(&oldArena, key), key.length, hash_val);
+                ht->liveBytes += recordSize(key.length);
+                placed = placeEntry(ht, firstBucket(ht, spreadHash(hash_val)), &tag, &copy);
+            }
+        }
+        if (placed) {
+            break;
+        }
+        delete[] ht->buckets;
+        freeArena(&ht->arena);
+        newBucketCount *= 2;
+    }
+    delete[] oldBuckets;
+    freeArena(&oldArena);
+}
+
+// Returns true if key (whose hash is hash_val) is stored.
+bool contains(CuckooHashTable* ht, const std::string &key, ull hash_val) {
+    ull spread = spreadHash(hash_val);
+    uint32_t tag = tagOf(spread);
+    uint64_t first = firstBucket(ht, spread);
+    uint64_t second = altBucket(ht, first, tag);
+    __builtin_prefetch(&ht->buckets[second]);
+    return findInBucket(ht, &ht->buckets[first], tag, key, hash_val) != -1 ||
+           findInBucket(ht, &ht->buckets[second], tag, key, hash_val) != -1;
+}
+
+// Search for a key; returns true if it is present.
+bool search(CuckooHashTable* ht, const std::string &key) {
+    return contains(ht, key, ht->hash(key));
+}
+
+// Insert a key. Returns true if it was added, false if it already exists
+// or is longer than MAX_KEY_LENGTH.
+bool insert(CuckooHashTable* ht, const std::string &key) {
+    if (key.size() > MAX_KEY_LENGTH) {
+        return false;
+    }
+    ull hash_val = ht->hash(key);
+    if (contains(ht, key, hash_val)) {
+        return false;
+    }
+    ull spread = spreadHash(hash_val);
+    uint32_t tag = tagOf(spread);
+    KeyRef stored = arenaAppend(&ht->arena, key.data(), key.size(), hash_val);
+    ht->liveBytes += recordSize(key.size());
+    ht->count++;
+    if (!placeEntry(ht, firstBucket(ht, spread), &tag, &stored)) {
+        rebuild(ht, 2 * (ht->bucketMask + 1), &tag, &stored);
+    }
+    return true;
+}
+
+// Remove a key; returns true if it was present.
+bool erase(CuckooHashTable* ht, const std::string &key) {
+    ull hash_val = ht->hash(key);
+    ull spread = spreadHash(hash_val);
+    uint32_t tag = tagOf(spread);
+    uint64_t first = firstBucket(ht, spread);
+    uint64_t candidates[2] = {first, altBucket(ht, first, tag)};
+    for (uint64_t b : candidates) {
+        Bucket *bucket = &ht->buckets[b];
+        int s = findInBucket(ht, bucket, tag, key, hash_val);
+        if (s == -1) {
+            continue;
+        }
+        ht->liveBytes -= recordSize(bucket->keys[s].length);
+        bucket->tags[s] = 0;
+        bucket->keys[s] = EMPTY_REF;
+        ht->count--;
+        if (ht->arena.used > COMPACT_MIN_BYTES && ht->arena.used - ht->liveBytes > ht->liveBytes) {
+            rebuild(ht, ht->bucketMask + 1, nullptr, nullptr);
+        }
+        return true;
+    }
+    return false;
+}
+
+double loadFactor(CuckooHashTable* ht) {
+    return (double)ht->count / ((ht->bucketMask + 1) * BUCKET_SLOTS);
+}
+
+// Free the buckets and, in one go, every key.
+void deleteCuckooHashTable(CuckooHashTable* ht) {
+    delete[] ht->buckets;
+    freeArena(&ht->arena);
+    delete ht;
+}
+
+// Fill a table from empty, then time individual hit and miss lookups and
+// print their latency percentiles. The tail stays within a few times the
+// median because no lookup ever reads more than two buckets.
+void runLatencyBenchmark(HashFunction hash) {
+    const int KEYS = 1 << 21;
+    const int LOOKUPS = 1 << 20;
+
+    CuckooHashTable* ht = createCuckooHashTable(0, hash);
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < KEYS; i++) {
+        insert(ht, "key" + to_string(i));
+    }
+    auto stop = chrono::steady_clock::now();
+    cout << "Inserted " << ht->count << " keys, "
+         << chrono::duration<double, nano>(stop - start).count() / KEYS << " ns/insert, load "
+         << loadFactor(ht) << endl;
+
+    std::mt19937_64 rng(11);
+    for (int pass = 0; pass < 2; pass++) {
+        // Pass 0 looks up stored keys, pass 1 keys that were never inserted.
+        std::vector<std::string> lookups(LOOKUPS);
+        for (int i = 0; i < LOOKUPS; i++) {
+            lookups[i] = (pass == 0 ? "key" : "absent") + to_string(rng() % KEYS);
+        }
+        std::vector<double> ns(LOOKUPS);
+        int hits = 0;
+        for (int i = 0; i < LOOKUPS; i++) {
+            auto t0 = chrono::steady_clock::now();
+            hits += search(ht, lookups[i]);
+            auto t1 = chrono::steady_clock::now();
+            ns[i] = chrono::duration<double, nano>(t1 - t0).count();
+        }
+        std::sort(ns.begin(), ns.end());
+        cout << (pass == 0 ? "hit " : "miss") << "  p50 " << ns[LOOKUPS / 2]
+             << " ns, p99 " << ns[(int)(LOOKUPS * 0.99)]
+             << " ns, p99.9 " << ns[(int)(LOOKUPS * 0.999)]
+             << " ns, max " << ns[LOOKUPS - 1] << " ns, " << hits << " hits" << endl;
+    }
+    deleteCuckooHashTable(ht);
+}
+
+int main(int argc, char* argv[]) {
+    // "latency [polynomial|mix|crc32c]" runs the benchmark with the chosen hash.
+    if (argc > 1 && string(argv[1]) == "latency") {
+        HashKind kind = HASH_MIX;
+        if (argc > 2 && !hashKindFromName(argv[2], &kind)) {
+            cout << "Unknown hash function: " << argv[2] << endl;
+            return 1;
+        }
+        runLatencyBenchmark(hashFunction(kind));
+        return 0;
+    }
+
+    CuckooHashTable* ht = createCuckooHashTable(0);
+
+    int n;
+    cout << "Enter number of strings to insert: ";
+    cin >> n;
+    cin.ignore();  // Clear newline from the input buffer.
+
+    std::string input;
+    for (int i = 0; i < n; i++) {
+        cout << "Enter string " << i + 1 << ": ";
+        getline(cin, input);
+        insert(ht, input);
+    }
+
+    cout << "\nEnter string to search: ";
+    getline(cin, input);
+    if (search(ht, input))
+        cout << "String found in the hash table." << endl;
+    else
+        cout << "String NOT found in the hash table." << endl;
+
+    deleteCuckooHashTable(ht);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,213 @@
+#include <iostream>
+#include <string>
+#include <cstdint>
+#include <algorithm>
+#include "hash_functions.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+// Requested number of slots (rounded up to a power of two by createHashTable).
+const int TABLE_SIZE = 101;
+
+// Slots are probed a whole group at a time: 32 control bytes per AVX2
+// compare, 16 per SSE2 compare, and a plain byte loop everywhere else.
+#if defined(__AVX2__)
+const int GROUP_WIDTH = 32;
+#else
+const int GROUP_WIDTH = 16;
+#endif
+
+// Control byte of an unused slot. Used slots hold a 7-bit hash fragment
+// (0..127), so the high bit alone tells empty from full.
+const int8_t CTRL_EMPTY = -128;
+
+// Some hash functions (the polynomial hash in particular) only fill the low
+// bits, so spread the hash over all 64 bits before splitting it into a group
+// index and a 7-bit fragment.
+ull spreadHash(ull h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// Hash table structure using open addressing with group probing.
+// ctrl[i] describes table[i]; keys are only compared when the fragment matches.
+struct HashTable {
+    int8_t *ctrl;        // One control byte per slot.
+    std::string **table; // Array of pointers to dynamically allocated keys.
+    int size;            // Number of slots (a power of two, multiple of GROUP_WIDTH).
+    int count;           // Number of keys stored.
+    HashFunction hash;   // Chosen when the table is created.
+};
+
+// Returns a bitmask with bit i set when ctrl[i] == value, for one group.
+unsigned matchGroup(const int8_t *ctrl, int8_t value) {
+#if defined(__AVX2__)
+    __m256i group = _mm256_loadu_si256((const __m256i *)ctrl);
+    return (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(group, _mm256_set1_epi8(value)));
+#elif defined(__SSE2__)
+    __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+    return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(value)));
+#else
+    unsigned mask = 0;
+    for (int i = 0; i < GROUP_WIDTH; i++) {
+        if (ctrl[i] == value) {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+#endif
+}
+
+// Create and initialize a hash table with at least the given number of slots.
+HashTable* createHashTable(int size, HashFunction hash = polynomialHash) {
+    int capacity = GROUP_WIDTH;
+    while (capacity < size) {
+        capacity *= 2;
+    }
+
+    HashTable* ht = new HashTable;
+    ht->size = capacity;
+    ht->count = 0;
+    ht->hash = hash;
+    ht->ctrl = new int8_t[capacity];
+    ht->table = new std::string*[capacity];
+    for (int i = 0; i < capacity; i++) {
+        ht->ctrl[i] = CTRL_EMPTY;
+        ht->table[i] = nullptr;
+    }
+    return ht;
+}
+
+// Walks the probe sequence for key and returns the slot holding it, or -1.
+// When the key is absent, *emptySlot receives the first free slot on the way
+// (or -1 if every group was full).
+int findSlot(HashTable* ht, const std::string &key, ull hash, int *emptySlot) {
+    int groups = ht->size / GROUP_WIDTH;
+    int group = (int)((hash >> 7) & (groups - 1));
+    int8_t fragment = (int8_t)(hash & 0x7F);
+    *emptySlot = -1;
+
+    // Triangular steps over a power-of-two group count visit every group once.
+    for (int step = 1; step <= groups; step++) {
+        int base = group * GROUP_WIDTH;
+        unsigned candidates = matchGroup(ht->ctrl + base, fragment);
+        while (candidates != 0) {
+            int slot = base + __builtin_ctz(candidates);
+            if (*(ht->table[slot]) == key) {
+                return slot;
+            }
+            candidates &= candidates - 1;
+        }
+        // Any empty slot ends the probe: the key would have been placed here.
+        unsigned empties = matchGroup(ht->ctrl + base, CTRL_EMPTY);
+        if (empties != 0) {
+            *emptySlot = base + __builtin_ctz(empties);
+            return -1;
+        }
+        group = (group + step) & (groups - 1);
+    }
+    return -1;
+}
+
+// Insert a key into the hash table using group probing.
+// Returns true if insertion is successful, false if the key already exists or table is full.
+bool insert(HashTable* ht, const std::string &key) {
+    ull hash_val = spreadHash(ht->hash(key));
+    int emptySlot;
+    if (findSlot(ht, key, hash_val, &emptySlot) != -1) {
+        return false;
+    }
+
+    // Keep at least one slot in eight free so unsuccessful probes stay short.
+    if (emptySlot == -1 || ht->count + 1 > ht->size - ht->size / 8) {
+        std::cout << "Hash table is full!" << std::endl;
+        return false;
+    }
+
+    ht->ctrl[emptySlot] = (int8_t)(hash_val & 0x7F);
+    ht->table[emptySlot] = new std::string(key);
+    ht->count++;
+    return true;
+}
+
+// Search for a key in the hash table using group probing.
+// Returns true if the key is found; otherwise, false.
+bool search(HashTable* ht, const std::string &key) {
+    int emptySlot;
+    return findSlot(ht, key, spreadHash(ht->hash(key)), &emptySlot) != -1;
+}
+
+// Number of lookups searchBatch keeps in flight at once.
+const int BATCH_WINDOW = 16;
+
+// Look up n keys at once; found[i] is set to whether keys[i] is present.
+// Keys are handled BATCH_WINDOW at a time: first every hash is computed and
+// the control bytes and slots of its first group are prefetched, and only
+// then is each probe resolved, so the cache misses of a whole window
+// overlap instead of being paid one after another.
+void searchBatch(HashTable* ht, const std::string *keys, int n, bool *found) {
+    ull hashes[BATCH_WINDOW];
+    int groups = ht->size / GROUP_WIDTH;
+    for (int base = 0; base < n; base += BATCH_WINDOW) {
+        int count = min(BATCH_WINDOW, n - base);
+        for (int i = 0; i < count; i++) {
+            hashes[i] = spreadHash(ht->hash(keys[base + i]));
+            int first = (int)((hashes[i] >> 7) & (groups - 1)) * GROUP_WIDTH;
+            __builtin_prefetch(ht->ctrl + first);
+            __builtin_prefetch(ht->table + first);
+        }
+
+        int emptySlot;
+        for (int i = 0; i < count; i++) {
+            found[base + i] = findSlot(ht, keys[base + i], hashes[i], &emptySlot) != -1;
+        }
+    }
+}
+
+// Free all dynamically allocated memory for the hash table.
+void deleteHashTable(HashTable* ht) {
+    for (int i = 0; i < ht->size; i++) {
+        if (ht->table[i] != nullptr) {
+            delete ht->table[i];
+        }
+    }
+    delete[] ht->ctrl;
+    delete[] ht->table;
+    delete ht;
+}
+
+int main() {
+    HashTable* ht = createHashTable(TABLE_SIZE);
+
+    int n;
+    cout << "Enter number of strings to insert: ";
+    cin >> n;
+    cin.ignore();  // Clear newline from the input buffer.
+
+    std::string input;
+    for (int i = 0; i < n; i++) {
+        cout << "Enter string " << i + 1 << ": ";
+        getline(cin, input);
+        insert(ht, input);
+    }
+
+    cout << "\nEnter string to search: ";
+    getline(cin, input);
+    if (search(ht, input))
+        cout << "String found in the hash table." << endl;
+    else
+        cout << "String NOT found in the hash table." << endl;
+
+    deleteHashTable(ht);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,216 @@
+#ifndef HASH_FUNCTIONS_H
+#define HASH_FUNCTIONS_H
+
+#include <string>
+#include <cstring>
+#include <cstdint>
+
+#ifdef __SSE4_2__
+#include <nmmintrin.h>
+#endif
+
+// String hash functions shared by the hash tables (linear_probe.cpp,
+// quad_probe.cpp, group_probe.cpp, string_hash.cpp). Every table takes a
+// HashFunction when it is created and defaults to polynomialHash.
+//
+//   polynomialHash  the original byte-at-a-time hash, kept for compatibility
+//   mixHash         word-at-a-time multiply-mix hash in the style of wyhash
+//   crc32cHash      CRC32C; uses the SSE4.2 crc32 instruction when compiled
+//                   with -msse4.2 (or -march=native), a lookup table otherwise
+
+typedef unsigned long long ull;
+
+// Signature shared by every hash function a table can be built with.
+typedef ull (*HashFunction)(const std::string &s);
+
+// The selectable hash families, in the order hashFunction() lists them.
+enum HashKind { HASH_POLYNOMIAL, HASH_MIX, HASH_CRC32C, HASH_KIND_COUNT };
+
+// Constants for the polynomial hash function.
+const ull POLY_MOD = 1000000007ULL;  // Large prime modulus to reduce collisions.
+const ull POLY_BASE = 31;            // Base value for hashing.
+
+// Computes a polynomial hash for a given string.
+// The hash is calculated as: hash(s) = Σ (s[i]-'a'+1) * p^i mod MOD.
+inline ull polynomialHash(const std::string &s) {
+    ull hash = 0;
+    ull p_pow = 1; // Represents p^0 initially.
+    for (size_t i = 0; i < s.size(); i++) {
+        int char_value = s[i] - 'a' + 1;  // Map 'a' -> 1, 'b' -> 2, etc.
+        hash = (hash + char_value * p_pow) % POLY_MOD;
+        p_pow = (p_pow * POLY_BASE) % POLY_MOD;
+    }
+    return hash;
+}
+
+// Unaligned little-endian loads.
+inline ull read64(const char *p) {
+    ull v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+inline ull read32(const char *p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+// 64x64 -> 128-bit multiply folded back to 64 bits.
+inline ull multiplyMix(ull a, ull b) {
+    unsigned __int128 r = (unsigned __int128)a * b;
+    return (ull)r ^ (ull)(r >> 64);
+}
+
+const ull MIX_SECRET0 = 0xa0761d6478bd642fULL;
+const ull MIX_SECRET1 = 0xe7037ed1a0b428dbULL;
+const ull MIX_SECRET2 = 0x8ebc6af09c88c6e3ULL;
+const ull MIX_SECRET3 = 0x589965cc75374cc3ULL;
+
+// Word-at-a-time hash of len bytes. Short keys are covered by two
+// overlapping loads; longer keys are consumed 16 or 48 bytes per round, each
+// round being one 128-bit multiply per 16 bytes. Different seeds give
+// independent hash functions.
+inline ull mixHashBytes(const char *data, size_t len, ull seed) {
+    seed ^= MIX_SECRET0;
+    ull a, b;
+    if (len <= 16) {
+        if (len >= 4) {
+            size_t mid = (len >> 3) << 2;
+            a = (read32(data) << 32) | read32(data + mid);
+            b = (read32(data + len - 4) << 32) | read32(data + len - 4 - mid);
+        } else if (len > 0) {
+            a = ((ull)(uint8_t)data[0] << 16) | ((ull)(uint8_t)data[len >> 1] << 8) |
+                (uint8_t)data[len - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        const char *p = data;
+        size_t i = len;
+        if (i > 48) {
+            // Three independent lanes keep the multipliers busy on long keys.
+            ull lane1 = seed, lane2 = seed;
+            do {
+                seed = multiplyMix(read64(p) ^ MIX_SECRET1, read64(p + 8) ^ seed);
+                lane1 = multiplyMix(read64(p + 16) ^ MIX_SECRET2, read64(p + 24) ^ lane1);
+                lane2 = multiplyMix(read64(p + 32) ^ MIX_SECRET3, read64(p + 40) ^ lane2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= lane1 ^ lane2;
+        }
+        while (i > 16) {
+            seed = multiplyMix(read64(p) ^ MIX_SECRET1, read64(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        // The last 16 bytes of the key, overlapping the previous round if needed.
+        a = read64(p + i - 16);
+        b = read64(p + i - 8);
+    }
+    return multiplyMix(MIX_SECRET1 ^ len, multiplyMix(a ^ MIX_SECRET1, b ^ seed));
+}
+
+inline ull mixHash(const std::string &s) {
+    return mixHashBytes(s.data(), s.size(), 0);
+}
+
+#ifndef __SSE4_2__
+// Byte-at-a-time lookup table for the portable CRC32C path.
+struct Crc32cTable {
+    uint32_t entry[256];
+};
+
+// Built once, on first use; a function-local static is initialised
+// thread-safely, so concurrent first calls are fine.
+inline const Crc32cTable &crc32cTable() {
+    static const Crc32cTable table = [] {
+        Crc32cTable t;
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int bit = 0; bit < 8; bit++) {
+                c = (c & 1) ? (c >> 1) ^ 0x82F63B78u : c >> 1;
+            }
+            t.entry[i] = c;
+        }
+        return t;
+    }();
+    return table;
+}
+#endif
+
+// CRC32C (Castagnoli polynomial, reflected) of len bytes.
+inline uint32_t crc32c(const char *data, size_t len) {
+    uint32_t crc = 0xFFFFFFFFu;
+#ifdef __SSE4_2__
+    ull crc64 = crc;
+    for (; len >= 8; data += 8, len -= 8) {
+        crc64 = _mm_crc32_u64(crc64, read64(data));
+    }
+    crc = (uint32_t)crc64;
+    for (; len > 0; data++, len--) {
+        crc = _mm_crc32_u8(crc, (uint8_t)*data);
+    }
+#else
+    const uint32_t *table = crc32cTable().entry;
+    for (; len > 0; data++, len--) {
+        crc = table[(crc ^ (uint8_t)*data) & 0xFF] ^ (crc >> 8);
+    }
+#endif
+    return crc ^ 0xFFFFFFFFu;
+}
+
+// CRC32C spread over 64 bits. Multiplying by an odd constant is a bijection,
+// so this adds no collisions, but tables that take high bits still see them vary.
+inline ull crc32cHash(const std::string &s) {
+    return (ull)crc32c(s.data(), s.size()) * 0x9E3779B97F4A7C15ULL;
+}
+
+// Look up the hash function for a family.
+inline HashFunction hashFunction(HashKind kind) {
+    switch (kind) {
+        case HASH_MIX:
+            return mixHash;
+        case HASH_CRC32C:
+            return crc32cHash;
+        default:
+            return polynomialHash;
+    }
+}
+
+inline const char *hashName(HashKind kind) {
+    switch (kind) {
+        case HASH_MIX:
+            return "mix";
+        case HASH_CRC32C:
+            return "crc32c";
+        default:
+            return "polynomial";
+    }
+}
+
+// Find the family of a hash function; returns false for any other function.
+inline bool hashKindOf(HashFunction hash, HashKind *kind) {
+    for (int k = 0; k < HASH_KIND_COUNT; k++) {
+        if (hash == hashFunction((HashKind)k)) {
+            *kind = (HashKind)k;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Parse a family name as printed by hashName; returns false if unknown.
+inline bool hashKindFromName(const std::string &name, HashKind *kind) {
+    for (int k = 0; k < HASH_KIND_COUNT; k++) {
+        if (name == hashName((HashKind)k)) {
+            *kind = (HashKind)k;
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif
\ No newline at end of file
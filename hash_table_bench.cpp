@@ -0,0 +1,341 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <unordered_set>
+#include <malloc.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "hash_functions.h"
+#include "linear_probe.h"
+#include "quad_probe.h"
+#include "string_hash.h"
+
+using namespace std;
+
+// Benchmark of the string hash tables against each other and std::unordered_set.
+//
+// Every table gets SLOTS slots (or buckets), is filled to each load factor in
+// LOADS and is then searched with LOOKUPS keys that are present and LOOKUPS
+// keys that are not. Three key distributions are used:
+//
+//   uniform      random 16-letter keys, looked up uniformly
+//   zipf         the same keys, looked up with Zipf(ZIPF_SKEW) popularity
+//   adversarial  keys whose polynomialHash is a multiple of 1024, so tables
+//                indexing by the low hash bits reach only 1/1024 of their
+//                slots (std::unordered_set uses std::hash and is unaffected)
+//
+// For each run it prints ns/op for insert, hit and miss lookups, the average
+// number of keys a successful search compares against, last-level cache
+// misses per lookup (from perf_event_open; "-" where the kernel does not
+// allow it) and the bytes of heap each stored key costs.
+//
+// Usage: hash_table_bench [polynomial|mix|crc32c]   (default polynomial)
+
+const int SLOTS = 1 << 20;
+const double LOADS[] = {0.25, 0.5, 0.7};
+const int LOOKUPS = 1 << 19;
+const int KEY_LENGTH = 16;
+const double ZIPF_SKEW = 0.99;
+const ull ADVERSARIAL_STRIDE = 1024;
+
+// One table under test. The table is passed around as an opaque pointer so
+// that every implementation runs through the same measuring code.
+struct TableOps {
+    const char *name;
+    void* (*create)(int slots, HashFunction hash);
+    bool (*insert)(void *table, const std::string &key);
+    bool (*search)(void *table, const std::string &key);
+    double (*averageProbe)(void *table);    // Keys compared per successful search.
+    void (*destroy)(void *table);
+};
+
+// ---------------- Table adapters ----------------
+
+void* linearCreate(int slots, HashFunction hash) {
+    return linear::createHashTable(slots, hash);
+}
+bool linearInsert(void *t, const std::string &key) {
+    return linear::insert((linear::HashTable*)t, key);
+}
+bool linearSearch(void *t, const std::string &key) {
+    return linear::search((linear::HashTable*)t, key);
+}
+double linearProbe(void *t) {
+    int maxProbe;
+    return linear::averageProbeLength((linear::HashTable*)t, &maxProbe);
+}
+void linearDestroy(void *t) {
+    linear::deleteHashTable((linear::HashTable*)t);
+}
+
+void* quadCreate(int slots, HashFunction hash) {
+    return quadratic::createHashTable(slots, false, hash);
+}
+void* robinHoodCreate(int slots, HashFunction hash) {
+    return quadratic::createHashTable(slots, true, hash);
+}
+bool quadInsert(void *t, const std::string &key) {
+    return quadratic::insert((quadratic::HashTable*)t, key);
+}
+bool quadSearch(void *t, const std::string &key) {
+    return quadratic::search((quadratic::HashTable*)t, key);
+}
+double quadProbe(void *t) {
+    quadratic::ProbeStats* stats = quadratic::getProbeStats((quadratic::HashTable*)t);
+    double average = stats->averageProbe;
+    quadratic::deleteProbeStats(stats);
+    return average;
+}
+void quadDestroy(void *t) {
+    quadratic::deleteHashTable((quadratic::HashTable*)t);
+}
+
+// The chained table does not check for duplicates; the benchmark never
+// inserts a key twice.
+void* chainedCreate(int slots, HashFunction hash) {
+    return chained::createHashTable(slots, hash);
+}
+bool chainedInsert(void *t, const std::string &key) {
+    chained::insert((chained::HashTable*)t, key);
+    return true;
+}
+bool chainedSearch(void *t, const std::string &key) {
+    return chained::search((chained::HashTable*)t, key);
+}
+double chainedProbe(void *t) {
+    chained::HashTable* ht = (chained::HashTable*)t;
+    long long total = 0, keys = 0;
+    for (int b = 0; b < ht->size; b++) {
+        int position = 0;
+        for (chained::Node* node = ht->buckets[b]; node != nullptr; node = node->next) {
+            total += ++position;
+            keys++;
+        }
+    }
+    return keys == 0 ? 0.0 : (double)total / keys;
+}
+void chainedDestroy(void *t) {
+    chained::deleteHashTable((chained::HashTable*)t);
+}
+
+// std::unordered_set hashes with std::hash; the HashFunction is ignored.
+typedef std::unordered_set<std::string> StdSet;
+
+void* stdCreate(int slots, HashFunction) {
+    StdSet *set = new StdSet;
+    set->max_load_factor(1.0);
+    set->rehash(slots);
+    return set;
+}
+bool stdInsert(void *t, const std::string &key) {
+    return ((StdSet*)t)->insert(key).second;
+}
+bool stdSearch(void *t, const std::string &key) {
+    return ((StdSet*)t)->count(key) != 0;
+}
+double stdProbe(void *t) {
+    StdSet *set = (StdSet*)t;
+    long long total = 0;
+    for (size_t b = 0; b < set->bucket_count(); b++) {
+        long long n = set->bucket_size(b);
+        total += n * (n + 1) / 2;
+    }
+    return set->empty() ? 0.0 : (double)total / set->size();
+}
+void stdDestroy(void *t) {
+    delete (StdSet*)t;
+}
+
+const TableOps TABLES[] = {
+    {"linear", linearCreate, linearInsert, linearSearch, linearProbe, linearDestroy},
+    {"quadratic", quadCreate, quadInsert, quadSearch, quadProbe, quadDestroy},
+    {"robin-hood", robinHoodCreate, quadInsert, quadSearch, quadProbe, quadDestroy},
+    {"chained", chainedCreate, chainedInsert, chainedSearch, chainedProbe, chainedDestroy},
+    {"unordered_set", stdCreate, stdInsert, stdSearch, stdProbe, stdDestroy},
+};
+
+// ---------------- Measurement helpers ----------------
+
+// Open a counter of last-level cache misses for this thread, or return -1
+// if perf events are unavailable (no PMU, or perf_event_paranoid too high).
+int openCacheMissCounter() {
+    struct perf_event_attr attr = {};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+void startCounter(int fd) {
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+// Stop the counter and return its value, or -1 if there is no counter.
+long long stopCounter(int fd) {
+    if (fd < 0) {
+        return -1;
+    }
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    long long value;
+    if (read(fd, &value, sizeof(value)) != sizeof(value)) {
+        return -1;
+    }
+    return value;
+}
+
+// Bytes currently allocated through malloc, including large mmapped blocks.
+size_t heapBytes() {
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+std::string randomKey(std::mt19937_64 &rng) {
+    std::string key(KEY_LENGTH, 'a');
+    for (int i = 0; i < KEY_LENGTH; i++) {
+        key[i] = 'a' + rng() % 26;
+    }
+    return key;
+}
+
+// A key whose polynomialHash is exactly value (value < POLY_MOD). The
+// characters '`' + d give character values d, so the key spells value in
+// base POLY_BASE.
+std::string keyWithPolynomialHash(ull value) {
+    std::string key;
+    do {
+        key += (char)('`' + value % POLY_BASE);
+        value /= POLY_BASE;
+    } while (value != 0);
+    return key;
+}
+
+// The keys to insert and the hit and miss lookups of one run.
+struct Workload {
+    std::vector<std::string> keys;
+    std::vector<std::string> hits;
+    std::vector<std::string> misses;
+};
+
+Workload makeWorkload(const std::string &distribution, int n, std::mt19937_64 &rng) {
+    Workload w;
+    if (distribution == "adversarial") {
+        // Misses come from the multiples just above the inserted ones.
+        for (int i = 0; i < n; i++) {
+            w.keys.push_back(keyWithPolynomialHash(i * ADVERSARIAL_STRIDE));
+        }
+        ull missRange = POLY_MOD / ADVERSARIAL_STRIDE - n;
+        for (int i = 0; i < LOOKUPS; i++) {
+            w.misses.push_back(keyWithPolynomialHash((n + rng() % missRange) * ADVERSARIAL_STRIDE));
+        }
+    } else {
+        for (int i = 0; i < n; i++) {
+            w.keys.push_back(randomKey(rng));
+        }
+        for (int i = 0; i < LOOKUPS; i++) {
+            w.misses.push_back(randomKey(rng));
+        }
+    }
+
+    if (distribution == "zipf") {
+        // Rank r (0-based) is looked up with probability proportional to 1/(r+1)^s.
+        std::vector<double> cdf(n);
+        double sum = 0;
+        for (int r = 0; r < n; r++) {
+            sum += 1.0 / std::pow(r + 1.0, ZIPF_SKEW);
+            cdf[r] = sum;
+        }
+        std::uniform_real_distribution<double> uniform(0.0, sum);
+        for (int i = 0; i < LOOKUPS; i++) {
+            int rank = std::upper_bound(cdf.begin(), cdf.end(), uniform(rng)) - cdf.begin();
+            w.hits.push_back(w.keys[std::min(rank, n - 1)]);
+        }
+    } else {
+        for (int i = 0; i < LOOKUPS; i++) {
+            w.hits.push_back(w.keys[rng() % n]);
+        }
+    }
+    return w;
+}
+
+// Time one lookup pass; returns ns per lookup and adds the hits to *found.
+double timeLookups(const TableOps &ops, void *table, const std::vector<std::string> &lookups, long long *found) {
+    auto start = chrono::steady_clock::now();
+    long long hits = 0;
+    for (const std::string &key : lookups) {
+        hits += ops.search(table, key);
+    }
+    auto stop = chrono::steady_clock::now();
+    *found += hits;
+    return chrono::duration<double, nano>(stop - start).count() / lookups.size();
+}
+
+void runBenchmark(HashFunction hash) {
+    const char *distributions[] = {"uniform", "zipf", "adversarial"};
+    int counter = openCacheMissCounter();
+    std::mt19937_64 rng(2024);
+
+    cout << "table\tdistribution\tload\tinsert ns\thit ns\tmiss ns\tavg probe\tLLC miss/lookup\tbytes/key" << endl;
+    for (const char *distribution : distributions) {
+        for (double load : LOADS) {
+            int n = (int)(load * SLOTS);
+            Workload w = makeWorkload(distribution, n, rng);
+
+            for (const TableOps &ops : TABLES) {
+                size_t heapBefore = heapBytes();
+                void *table = ops.create(SLOTS, hash);
+                auto start = chrono::steady_clock::now();
+                for (const std::string &key : w.keys) {
+                    ops.insert(table, key);
+                }
+                auto stop = chrono::steady_clock::now();
+                double insertNs = chrono::duration<double, nano>(stop - start).count() / n;
+                double bytesPerKey = (double)(heapBytes() - heapBefore) / n;
+
+                long long found = 0;
+                startCounter(counter);
+                double hitNs = timeLookups(ops, table, w.hits, &found);
+                double missNs = timeLookups(ops, table, w.misses, &found);
+                long long cacheMisses = stopCounter(counter);
+                if (found != LOOKUPS) {
+                    cout << "unexpected lookup results for " << ops.name << endl;
+                }
+
+                cout << ops.name << "\t" << distribution << "\t" << load << "\t" << insertNs
+                     << "\t" << hitNs << "\t" << missNs << "\t" << ops.averageProbe(table) << "\t";
+                if (cacheMisses < 0) {
+                    cout << "-";
+                } else {
+                    cout << (double)cacheMisses / (2 * LOOKUPS);
+                }
+                cout << "\t" << bytesPerKey << endl;
+                ops.destroy(table);
+            }
+        }
+    }
+    if (counter >= 0) {
+        close(counter);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    HashKind kind = HASH_POLYNOMIAL;
+    if (argc > 1 && !hashKindFromName(argv[1], &kind)) {
+        cout << "Unknown hash function: " << argv[1] << endl;
+        return 1;
+    }
+    cout << "hash " << hashName(kind) << ", " << SLOTS << " slots" << endl;
+    runBenchmark(hashFunction(kind));
+    return 0;
+}
\ No newline at end of file
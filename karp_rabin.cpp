@@ -1,14 +1,606 @@
 #include <iostream>
+#include <fstream>
+#include <sstream>
 #include <string>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <thread>
+#include <random>
+#include <cstdint>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 using namespace std;
 
-typedef long long ll;
+typedef unsigned long long ull;
+
+// Rolling hashes are polynomials in a random base modulo the Mersenne prime
+// 2^61 - 1. Reducing modulo 2^61 - 1 needs only a shift and an add, and two
+// different windows of length L collide with probability at most L / 2^61
+// for a base drawn at random, so fingerprint hits are almost always real
+// matches and verification rarely does wasted work.
+const ull MERSENNE_61 = (1ULL << 61) - 1;
+
+// Reduce x < 2^63 modulo 2^61 - 1.
+inline ull reduce61(ull x) {
+    x = (x & MERSENNE_61) + (x >> 61);
+    return x >= MERSENNE_61 ? x - MERSENNE_61 : x;
+}
+
+// a * b mod 2^61 - 1 for a, b < 2^61 - 1, via one 64x64 -> 128-bit multiply,
+// left partly reduced: the result is congruent and below 2^62.
+inline ull mulMod61Lazy(ull a, ull b) {
+    unsigned __int128 product = (unsigned __int128)a * b;
+    return ((ull)product & MERSENNE_61) + (ull)(product >> 61);
+}
+
+inline ull mulMod61(ull a, ull b) {
+    return reduce61(mulMod61Lazy(a, b));
+}
+
+// A fresh random base in [2^32, 2^61 - 1) for each pattern set.
+ull randomBase() {
+    std::random_device device;
+    std::mt19937_64 rng(((ull)device() << 32) ^ device() ^
+                        (ull)chrono::steady_clock::now().time_since_epoch().count());
+    return (1ULL << 32) + rng() % (MERSENNE_61 - (1ULL << 32));
+}
+
+// Called for every occurrence found: the index of the pattern that matched
+// and the offset in the text where the occurrence starts.
+typedef void (*MatchCallback)(int pattern, long long position, void *context);
+
+// ---------------- Multi-pattern search ----------------
+//
+// Patterns are grouped by length. Each group keeps one rolling hash over the
+// text and a small open-addressing table of its patterns' fingerprints, so
+// one pass over the text checks every window against every pattern of that
+// length with a single table probe. Fingerprint hits are verified with
+// memcmp before they are reported.
+
+// One entry of a group's fingerprint table. The fingerprint is kept in the
+// slot so that a probe touches nothing else unless it matches.
+struct FingerprintSlot {
+    ull fingerprint;
+    int pattern;               // First pattern with this fingerprint, -1 if empty.
+};
+
+// Patterns of one length.
+struct LengthGroup {
+    int length;
+    // dropTerm[c] = -charValue(c) * base^length mod 2^61 - 1: adding it
+    // removes byte c from the front of a window of this length.
+    ull dropTerm[256];
+    std::vector<FingerprintSlot> slots;  // Size is a power of two.
+};
+
+struct PatternSet {
+    std::vector<std::string> patterns;
+    ull base;                         // Random polynomial base of the rolling hashes.
+    std::vector<ull> fingerprints;    // Rolling hash of each pattern.
+    std::vector<int> sameFingerprint; // Next pattern of the group with an equal fingerprint, or -1.
+    std::vector<LengthGroup> groups;
+    int maxLength;                    // Longest pattern, in bytes.
+    int singlePattern;                // Index of the only non-empty pattern, or -1.
+};
+
+// Value of a byte in the rolling hash; never zero, so leading bytes count.
+inline ull charValue(char c) {
+    return (unsigned char)c + 1;
+}
+
+// Hash of len bytes in the form the rolling hash produces:
+// Σ charValue(s[i]) * base^(len-1-i) mod 2^61 - 1.
+ull windowHash(const char *s, int len, ull base) {
+    ull hash = 0;
+    for (int i = 0; i < len; i++) {
+        hash = reduce61(mulMod61(hash, base) + charValue(s[i]));
+    }
+    return hash;
+}
+
+inline int fingerprintSlot(ull fingerprint, int mask) {
+    return (int)((fingerprint * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+}
+
+// Group the patterns by length and index their fingerprints.
+// Empty patterns are kept (so indices stay stable) but never match.
+PatternSet* buildPatternSet(const std::vector<std::string> &patterns) {
+    PatternSet* set = new PatternSet;
+    set->patterns = patterns;
+    set->fingerprints.resize(patterns.size());
+    set->sameFingerprint.assign(patterns.size(), -1);
+    set->maxLength = 0;
+    set->singlePattern = -1;
+    set->base = randomBase();
+    int nonEmpty = 0;
+
+    for (int i = 0; i < (int)patterns.size(); i++) {
+        int len = patterns[i].size();
+        if (len == 0) {
+            continue;
+        }
+        set->fingerprints[i] = windowHash(patterns[i].data(), len, set->base);
+        set->maxLength = std::max(set->maxLength, len);
+        set->singlePattern = (++nonEmpty == 1) ? i : -1;
+
+        LengthGroup *group = nullptr;
+        for (LengthGroup &g : set->groups) {
+            if (g.length == len) {
+                group = &g;
+            }
+        }
+        if (group == nullptr) {
+            set->groups.push_back(LengthGroup());
+            group = &set->groups.back();
+            group->length = len;
+            ull powLength = 1;
+            for (int k = 0; k < len; k++) {
+                powLength = mulMod61(powLength, set->base);
+            }
+            for (int c = 0; c < 256; c++) {
+                group->dropTerm[c] = MERSENNE_61 - mulMod61(charValue((char)c), powLength);
+            }
+        }
+        group->slots.push_back(FingerprintSlot{0, i});  // Collected here, placed below.
+    }
+
+    // Replace each group's pattern list with a table at most 1/8 full, so
+    // almost every window of the text is rejected by one empty slot.
+    for (LengthGroup &g : set->groups) {
+        std::vector<FingerprintSlot> members;
+        members.swap(g.slots);
+        int size = 8;
+        while (size < 8 * (int)members.size()) {
+            size *= 2;
+        }
+        g.slots.assign(size, FingerprintSlot{0, -1});
+        for (const FingerprintSlot &member : members) {
+            int id = member.pattern;
+            ull fingerprint = set->fingerprints[id];
+            int slot = fingerprintSlot(fingerprint, size - 1);
+            while (g.slots[slot].pattern != -1 && g.slots[slot].fingerprint != fingerprint) {
+                slot = (slot + 1) & (size - 1);
+            }
+            // Patterns sharing a fingerprint hang off the first one.
+            set->sameFingerprint[id] = g.slots[slot].pattern;
+            g.slots[slot] = FingerprintSlot{fingerprint, id};
+        }
+    }
+    return set;
+}
+
+// First pattern of the group whose fingerprint equals hash, or -1.
+inline int findFingerprint(const LengthGroup &g, ull hash) {
+    int mask = g.slots.size() - 1;
+    int slot = fingerprintSlot(hash, mask);
+    while (g.slots[slot].pattern != -1) {
+        if (g.slots[slot].fingerprint == hash) {
+            return g.slots[slot].pattern;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+
+// ---------------- Single-pattern candidate filter ----------------
+//
+// A set with one pattern skips hashing altogether. Start positions are
+// tested FILTER_WIDTH at a time by comparing the text against the pattern's
+// first byte and, shifted by m - 1, against its last byte (32 positions per
+// pair of AVX2 compares, 16 per SSE2 pair, a plain loop elsewhere). Only
+// positions where both bytes agree reach memcmp, which for typical text is
+// a small fraction of them.
+
+#if defined(__AVX2__)
+const int FILTER_WIDTH = 32;
+#else
+const int FILTER_WIDTH = 16;
+#endif
+
+// Bit k set when first[k] == firstByte and last[k] == lastByte.
+inline unsigned candidateMask(const char *first, const char *last, char firstByte, char lastByte) {
+#if defined(__AVX2__)
+    __m256i a = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)first), _mm256_set1_epi8(firstByte));
+    __m256i b = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)last), _mm256_set1_epi8(lastByte));
+    return (unsigned)_mm256_movemask_epi8(_mm256_and_si256(a, b));
+#elif defined(__SSE2__)
+    __m128i a = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)first), _mm_set1_epi8(firstByte));
+    __m128i b = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)last), _mm_set1_epi8(lastByte));
+    return (unsigned)_mm_movemask_epi8(_mm_and_si128(a, b));
+#else
+    unsigned mask = 0;
+    for (int k = 0; k < FILTER_WIDTH; k++) {
+        if (first[k] == firstByte && last[k] == lastByte) {
+            mask |= 1u << k;
+        }
+    }
+    return mask;
+#endif
+}
+
+// Report the occurrences of the set's only pattern that end at stream
+// offsets [from, to). text is indexed by stream offset, as in scanRange.
+void scanCandidates(const PatternSet* set, const char *text, long long from, long long to,
+                    MatchCallback onMatch, void *context) {
+    int id = set->singlePattern;
+    const char *pattern = set->patterns[id].data();
+    int m = set->patterns[id].size();
+    char firstByte = pattern[0], lastByte = pattern[m - 1];
+
+    long long start = std::max(0LL, from - m + 1);
+    long long end = to - m + 1;  // One past the last start position.
+    for (; start + FILTER_WIDTH <= end; start += FILTER_WIDTH) {
+        unsigned mask = candidateMask(text + start, text + start + m - 1, firstByte, lastByte);
+        while (mask != 0) {
+            long long candidate = start + __builtin_ctz(mask);
+            if (m <= 2 || memcmp(text + candidate + 1, pattern + 1, m - 2) == 0) {
+                onMatch(id, candidate, context);
+            }
+            mask &= mask - 1;
+        }
+    }
+    for (; start < end; start++) {
+        if (text[start] == firstByte && text[start + m - 1] == lastByte &&
+            memcmp(text + start, pattern, m) == 0) {
+            onMatch(id, start, context);
+        }
+    }
+}
+
+// Advance every group's rolling hash (hashes[g] for group g) over the
+// bytes at stream offsets [from, to) and report the occurrences ending
+// there. buf[k] holds the byte at stream offset base + k; it must reach back
+// maxLength bytes before `from` (or to the start of the stream), because
+// the windows ending in [from, to) start and drop bytes up to that far back.
+// A set with a single pattern goes through scanCandidates instead and
+// leaves the hashes alone.
+void scanRange(const PatternSet* set, ull *hashes, const char *buf, long long base,
+               long long from, long long to, MatchCallback onMatch, void *context) {
+    int groupCount = set->groups.size();
+    const char *text = buf - base;  // Indexed by stream offset.
+    if (set->singlePattern != -1) {
+        scanCandidates(set, text, from, to, onMatch, context);
+        return;
+    }
+
+    for (long long i = from; i < to; i++) {
+        ull in = charValue(text[i]);
+        for (int g = 0; g < groupCount; g++) {
+            const LengthGroup &group = set->groups[g];
+            // Add the new byte and drop the one that just left the window.
+            // The terms sum to less than 2^63, so one reduction covers them.
+            ull drop = (i >= group.length) ? group.dropTerm[(unsigned char)text[i - group.length]] : 0;
+            ull hash = reduce61(mulMod61Lazy(hashes[g], set->base) + in + drop);
+            hashes[g] = hash;
+            if (i + 1 < group.length) {
+                continue;
+            }
+            long long start = i + 1 - group.length;
+            for (int id = findFingerprint(group, hash); id != -1; id = set->sameFingerprint[id]) {
+                if (memcmp(text + start, set->patterns[id].data(), group.length) == 0) {
+                    onMatch(id, start, context);
+                }
+            }
+        }
+    }
+}
+
+// Report every occurrence of every pattern in text[0..n) with one pass over
+// the text. Occurrences come out in order of their end position.
+void searchPatterns(const PatternSet* set, const char *text, long long n,
+                    MatchCallback onMatch, void *context) {
+    std::vector<ull> hashes(set->groups.size(), 0);
+    scanRange(set, hashes.data(), text, 0, 0, n, onMatch, context);
+}
+
+// ---------------- Streaming search ----------------
+//
+// Both streaming searches keep only the rolling hashes and a window of
+// recent bytes, so memory does not grow with the input: searchFd copies
+// STREAM_CHUNK bytes at a time behind the last maxLength bytes of the
+// previous chunk, which is what windows straddling the boundary need, and
+// searchMappedFile scans the mapping in place and hands pages it has
+// finished with back to the kernel.
+
+const size_t STREAM_CHUNK = 1 << 20;
+
+// Search everything read from fd until end of file. Returns false on a
+// read error; matches reported up to that point stand.
+bool searchFd(const PatternSet* set, int fd, MatchCallback onMatch, void *context) {
+    size_t keep = set->maxLength;
+    std::vector<char> buffer(keep + STREAM_CHUNK);
+    std::vector<ull> hashes(set->groups.size(), 0);
+    long long base = 0;     // Stream offset of buffer[0].
+    size_t filled = 0;      // Bytes of buffer holding data; never more than keep here.
+
+    while (true) {
+        ssize_t got = read(fd, buffer.data() + filled, STREAM_CHUNK);
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        if (got == 0) {
+            return true;
+        }
+        long long from = base + filled;
+        scanRange(set, hashes.data(), buffer.data(), base, from, from + got, onMatch, context);
+        filled += got;
+
+        // Carry the tail over for windows that end in the next chunk.
+        size_t carry = std::min(filled, keep);
+        memmove(buffer.data(), buffer.data() + filled - carry, carry);
+        base += filled - carry;
+        filled = carry;
+    }
+}
+
+// Map a whole file read-only. An empty file gives *data == nullptr.
+// Returns false if the file cannot be opened or mapped.
+bool mapFile(const char *path, char **data, long long *size) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+    *size = st.st_size;
+    *data = nullptr;
+    if (*size > 0) {
+        void *mapping = mmap(nullptr, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            *data = (char *)mapping;
+        }
+    }
+    close(fd);  // The mapping stays valid after the descriptor is closed.
+    return *size == 0 || *data != nullptr;
+}
+
+void unmapFile(char *data, long long size) {
+    if (data != nullptr) {
+        munmap(data, size);
+    }
+}
+
+// Search a file through a read-only mapping, STREAM_CHUNK bytes at a time.
+// Returns false if the file cannot be opened or mapped.
+bool searchMappedFile(const PatternSet* set, const char *path, MatchCallback onMatch, void *context) {
+    char *data;
+    long long size;
+    if (!mapFile(path, &data, &size)) {
+        return false;
+    }
+    if (size == 0) {
+        return true;
+    }
+    madvise(data, size, MADV_SEQUENTIAL);
+
+    long long pageSize = sysconf(_SC_PAGESIZE);
+    long long released = 0;  // Pages before this offset have been dropped.
+    std::vector<ull> hashes(set->groups.size(), 0);
+    for (long long from = 0; from < size; from += STREAM_CHUNK) {
+        long long to = std::min<long long>(size, from + STREAM_CHUNK);
+        scanRange(set, hashes.data(), data, 0, from, to, onMatch, context);
+        // Later windows reach back at most maxLength bytes; drop whole pages before that.
+        long long done = (to - set->maxLength) / pageSize * pageSize;
+        if (done > released) {
+            madvise(data + released, done - released, MADV_DONTNEED);
+            released = done;
+        }
+    }
+    unmapFile(data, size);
+    return true;
+}
+
+// ---------------- Parallel search ----------------
+//
+// The text is cut into one range of starting offsets per thread. Each
+// thread runs its own rolling hashes over its range plus the maxLength - 1
+// bytes after it, so every window starting in the range is seen whole, and
+// keeps only the occurrences that start inside its range. The ranges are
+// disjoint and in order, so sorting each thread's list and concatenating
+// the lists yields all occurrences sorted by (position, pattern).
+
+// Smallest range worth a thread of its own.
+const long long MIN_PARALLEL_CHUNK = 1 << 16;
 
-const ll MOD = 1000000007;  // A large prime modulus
-const ll p = 31;            // Base used for the polynomial hash
+struct Match {
+    long long position;
+    int pattern;
+};
+
+inline bool operator<(const Match &a, const Match &b) {
+    return a.position < b.position || (a.position == b.position && a.pattern < b.pattern);
+}
+
+// Occurrences found by one thread. Offsets passed to collectMatch are
+// relative to `start`; only those below `limit` belong to this thread.
+struct ChunkMatches {
+    long long start;
+    long long limit;
+    std::vector<Match> matches;
+};
+
+void collectMatch(int pattern, long long position, void *context) {
+    ChunkMatches *chunk = (ChunkMatches *)context;
+    if (position < chunk->limit) {
+        chunk->matches.push_back(Match{chunk->start + position, pattern});
+    }
+}
+
+// Find every occurrence in text[0..n) using up to `threads` threads.
+// Returns them sorted by position, then pattern index.
+std::vector<Match> searchParallel(const PatternSet* set, const char *text, long long n, int threads) {
+    long long chunkSize = std::max(MIN_PARALLEL_CHUNK, (n + threads - 1) / std::max(threads, 1));
+    int chunkCount = std::max(1LL, (n + chunkSize - 1) / chunkSize);
+    std::vector<ChunkMatches> chunks(chunkCount);
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < chunkCount; t++) {
+        workers.emplace_back([&, t]() {
+            ChunkMatches &chunk = chunks[t];
+            chunk.start = t * chunkSize;
+            chunk.limit = std::min(chunkSize, n - chunk.start);
+            // Overlap the next range by maxLength - 1 bytes.
+            long long end = std::min(n, chunk.start + chunk.limit + std::max(set->maxLength - 1, 0));
+            searchPatterns(set, text + chunk.start, end - chunk.start, collectMatch, &chunk);
+            std::sort(chunk.matches.begin(), chunk.matches.end());
+        });
+    }
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+
+    size_t total = 0;
+    for (const ChunkMatches &chunk : chunks) {
+        total += chunk.matches.size();
+    }
+    std::vector<Match> merged;
+    merged.reserve(total);
+    for (const ChunkMatches &chunk : chunks) {
+        merged.insert(merged.end(), chunk.matches.begin(), chunk.matches.end());
+    }
+    return merged;
+}
+
+void deletePatternSet(PatternSet* set) {
+    delete set;
+}
+
+bool readFile(const char *path, std::string *contents) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    *contents = buffer.str();
+    return true;
+}
+
+// Read one pattern per line.
+bool readPatterns(const char *path, std::vector<std::string> *patterns) {
+    std::string patternText;
+    if (!readFile(path, &patternText)) {
+        return false;
+    }
+    std::istringstream lines(patternText);
+    std::string line;
+    while (getline(lines, line)) {
+        patterns->push_back(line);
+    }
+    return true;
+}
+
+void collectPosition(int, long long position, void *context) {
+    ((std::vector<long long> *)context)->push_back(position);
+}
+
+void printMatch(int pattern, long long position, void *context) {
+    const PatternSet* set = (const PatternSet*)context;
+    cout << position << "\t" << set->patterns[pattern] << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    // "multi PATTERN_FILE TEXT_FILE" finds every line of PATTERN_FILE in
+    // TEXT_FILE in a single pass and prints "offset<TAB>pattern" per match.
+    if (argc > 3 && string(argv[1]) == "multi") {
+        std::vector<std::string> patterns;
+        std::string text;
+        if (!readPatterns(argv[2], &patterns) || !readFile(argv[3], &text)) {
+            cout << "Could not read input files." << endl;
+            return 1;
+        }
+
+        PatternSet* set = buildPatternSet(patterns);
+        auto start = chrono::steady_clock::now();
+        searchPatterns(set, text.data(), text.size(), printMatch, set);
+        auto stop = chrono::steady_clock::now();
+        cerr << patterns.size() << " patterns in " << set->groups.size() << " length groups, "
+             << text.size() << " bytes scanned in " << chrono::duration<double>(stop - start).count()
+             << " s" << endl;
+        deletePatternSet(set);
+        return 0;
+    }
+    // "parallel PATTERN_FILE FILE [THREADS]" searches a mapped FILE with
+    // THREADS threads (default: one per core) and prints the matches in order.
+    // "scale PATTERN_FILE FILE" only reports throughput for 1, 2, 4, ... threads.
+    if (argc > 3 && (string(argv[1]) == "parallel" || string(argv[1]) == "scale")) {
+        std::vector<std::string> patterns;
+        char *text;
+        long long n;
+        if (!readPatterns(argv[2], &patterns) || !mapFile(argv[3], &text, &n)) {
+            cout << "Could not read input files." << endl;
+            return 1;
+        }
+        PatternSet* set = buildPatternSet(patterns);
+        int cores = std::max(1u, std::thread::hardware_concurrency());
+
+        if (string(argv[1]) == "parallel") {
+            int threads = argc > 4 ? atoi(argv[4]) : cores;
+            std::vector<Match> matches = searchParallel(set, text, n, threads);
+            for (const Match &match : matches) {
+                printMatch(match.pattern, match.position, set);
+            }
+        } else {
+            cout << "threads\tGB/s\tmatches" << endl;
+            for (int threads = 1; threads <= 2 * cores; threads *= 2) {
+                auto start = chrono::steady_clock::now();
+                size_t found = searchParallel(set, text, n, threads).size();
+                auto stop = chrono::steady_clock::now();
+                cout << threads << "\t" << n / chrono::duration<double>(stop - start).count() / 1e9
+                     << "\t" << found << endl;
+            }
+        }
+        deletePatternSet(set);
+        unmapFile(text, n);
+        return 0;
+    }
+    // "stream PATTERN_FILE [FILE [mmap]]" does the same without loading the
+    // text: FILE (or stdin if absent or "-") is read in fixed-size chunks,
+    // or scanned through a mapping when "mmap" is given.
+    if (argc > 2 && string(argv[1]) == "stream") {
+        std::vector<std::string> patterns;
+        if (!readPatterns(argv[2], &patterns)) {
+            cout << "Could not read pattern file " << argv[2] << endl;
+            return 1;
+        }
+        PatternSet* set = buildPatternSet(patterns);
+        bool fromStdin = argc < 4 || string(argv[3]) == "-";
+        bool ok;
+        if (!fromStdin && argc > 4 && string(argv[4]) == "mmap") {
+            ok = searchMappedFile(set, argv[3], printMatch, set);
+        } else {
+            int fd = fromStdin ? 0 : open(argv[3], O_RDONLY);
+            ok = fd >= 0 && searchFd(set, fd, printMatch, set);
+            if (fd > 0) {
+                close(fd);
+            }
+        }
+        deletePatternSet(set);
+        if (!ok) {
+            cout << "Could not read " << (fromStdin ? "standard input" : argv[3]) << endl;
+            return 1;
+        }
+        return 0;
+    }
 
-int main() {
     // Read input text and pattern
     string text, pattern;
     cout << "Enter text: ";
@@ -16,70 +608,30 @@ int main() {
     cout << "Enter pattern: ";
     getline(cin, pattern);
 
-    int n = text.size();
-    int m = pattern.size();
-    
-    if (m > n) {
-        cout << "Pattern not found." << endl;
-        return 0;
-    }
-
-    // Allocate arrays for powers of p and prefix hashes for the text.
-    ll* p_pow = new ll[n + 1];
-    ll* h = new ll[n + 1];
-    
-    // Precompute powers of p: p_pow[i] = p^i mod MOD
-    p_pow[0] = 1;
-    for (int i = 1; i <= n; i++) {
-        p_pow[i] = (p_pow[i - 1] * p) % MOD;
-    }
-    
-    // Compute prefix hashes for the text:
-    // h[i+1] = (h[i] + (text[i]-'a'+1) * p_pow[i]) mod MOD
-    h[0] = 0;
-    for (int i = 0; i < n; i++) {
-        h[i + 1] = (h[i] + (text[i] - 'a' + 1) * p_pow[i]) % MOD;
-    }
-    
-    // Compute the hash of the pattern using the same method.
-    ll pattern_hash = 0;
-    for (int i = 0; i < m; i++) {
-        pattern_hash = (pattern_hash + (pattern[i] - 'a' + 1) * p_pow[i]) % MOD;
-    }
-    
-    // Allocate a dynamic array to store occurrence indices.
-    // In worst-case, every position could be an occurrence.
-    int* occ = new int[n];
-    int occCount = 0;
-    
-    // Slide over every possible starting index in text
-    for (int i = 0; i <= n - m; i++) {
-        // Calculate hash for the current substring text[i...i+m-1]
-        ll cur_hash = (h[i + m] + MOD - h[i]) % MOD;
-        // Adjust for the power factor: cur_hash should equal pattern_hash * p_pow[i] mod MOD
-        if (cur_hash == (pattern_hash * p_pow[i]) % MOD) {
-            // Verify the substring to rule out false positives due to hash collisions
-            if (text.substr(i, m) == pattern) {
-                occ[occCount++] = i;
-            }
+    // Search with a one-pattern set; occurrences arrive in increasing order.
+    // Pattern sets never match an empty pattern, but on its own it occurs at
+    // every index 0..n, as it always has here.
+    PatternSet* set = buildPatternSet(std::vector<std::string>(1, pattern));
+    std::vector<long long> occ;
+    if (pattern.empty()) {
+        for (long long i = 0; i <= (long long)text.size(); i++) {
+            occ.push_back(i);
         }
+    } else {
+        searchPatterns(set, text.data(), text.size(), collectPosition, &occ);
     }
-    
+
     // Output the results
-    if (occCount == 0) {
+    if (occ.empty()) {
         cout << "Pattern not found." << endl;
     } else {
         cout << "Pattern found at indices: ";
-        for (int i = 0; i < occCount; i++) {
-            cout << occ[i] << " ";
+        for (long long position : occ) {
+            cout << position << " ";
         }
         cout << endl;
     }
-    
-    // Clean up dynamically allocated memory
-    delete[] p_pow;
-    delete[] h;
-    delete[] occ;
-    
+
+    deletePatternSet(set);
     return 0;
 }
\ No newline at end of file
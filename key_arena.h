@@ -0,0 +1,110 @@
+#ifndef KEY_ARENA_H
+#define KEY_ARENA_H
+
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include "hash_functions.h"
+
+// Bump-allocated key storage for the open-addressing tables
+// (linear_probe.cpp, quad_probe.cpp).
+//
+// Every key is appended to one growing block of memory as its 8-byte hash
+// followed by its characters, and a table slot holds only a KeyRef: the
+// record's offset in the arena and the key's length, packed into 8 bytes.
+// Inserting a key is a copy into the arena instead of two heap allocations,
+// keys end up next to each other in memory, the stored hash lets a resize
+// move keys without rehashing them, and the whole arena is released with
+// one free. Keys longer than MAX_KEY_LENGTH cannot be stored.
+//
+// Offsets are stored one past the record's start, so an unused slot is all
+// zero bytes and a table of them can come straight from calloc.
+
+struct KeyRef {
+    uint64_t offset : 40;   // One past the start of the key's record in the arena.
+    uint64_t length : 24;   // Key length in bytes.
+};
+
+const uint64_t EMPTY_OFFSET = 0;  // Offset of an unused slot.
+const uint64_t MAX_KEY_LENGTH = (1ULL << 24) - 1;
+const KeyRef EMPTY_REF = {EMPTY_OFFSET, 0};
+
+struct KeyArena {
+    char *data;
+    uint64_t used;
+    uint64_t capacity;
+};
+
+inline bool isEmpty(KeyRef ref) {
+    return ref.offset == EMPTY_OFFSET;
+}
+
+inline void initArena(KeyArena *arena) {
+    arena->data = nullptr;
+    arena->used = 0;
+    arena->capacity = 0;
+}
+
+// Bytes a key of this length takes up in the arena.
+inline uint64_t recordSize(uint64_t length) {
+    return sizeof(ull) + length;
+}
+
+// Append a key with its hash and return a reference to it.
+// The arena doubles when full; large blocks are moved by the kernel's page
+// remapping rather than copied byte by byte.
+inline KeyRef arenaAppend(KeyArena *arena, const char *key, uint64_t length, ull hash_val) {
+    uint64_t needed = arena->used + recordSize(length);
+    if (needed > arena->capacity) {
+        uint64_t capacity = arena->capacity == 0 ? 4096 : arena->capacity;
+        while (capacity < needed) {
+            capacity *= 2;
+        }
+        char *data = (char *)realloc(arena->data, capacity);
+        if (data == nullptr) {
+            throw std::bad_alloc();
+        }
+        arena->data = data;
+        arena->capacity = capacity;
+    }
+    KeyRef ref;
+    ref.offset = arena->used + 1;
+    ref.length = length;
+    memcpy(arena->data + arena->used, &hash_val, sizeof(ull));
+    memcpy(arena->data + arena->used + sizeof(ull), key, length);
+    arena->used = needed;
+    return ref;
+}
+
+// Pointer to the record (hash, then characters) of a stored key.
+inline const char *arenaRecord(const KeyArena *arena, KeyRef ref) {
+    return arena->data + ref.offset - 1;
+}
+
+// Pointer to the characters of a stored key.
+inline const char *arenaKey(const KeyArena *arena, KeyRef ref) {
+    return arenaRecord(arena, ref) + sizeof(ull);
+}
+
+// Hash of a stored key, as computed when it was inserted.
+inline ull arenaHash(const KeyArena *arena, KeyRef ref) {
+    ull hash_val;
+    memcpy(&hash_val, arenaRecord(arena, ref), sizeof(ull));
+    return hash_val;
+}
+
+// Returns true if ref holds key (whose hash is hash_val). The stored hash
+// and length turn away almost every mismatch before any characters are compared.
+inline bool keyEquals(const KeyArena *arena, KeyRef ref, const std::string &key, ull hash_val) {
+    return ref.length == key.size() && arenaHash(arena, ref) == hash_val &&
+           memcmp(arenaKey(arena, ref), key.data(), key.size()) == 0;
+}
+
+inline void freeArena(KeyArena *arena) {
+    free(arena->data);
+    initArena(arena);
+}
+
+#endif
\ No newline at end of file
@@ -1,105 +1,416 @@
 #include <iostream>
 #include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <fstream>
+#include <cstdint>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "hash_functions.h"
+#include "linear_probe.h"
 
 using namespace std;
+using namespace linear;
 
-typedef unsigned long long ull;
+// ---------------- Memory-mapped form ----------------
+//
+// saveHashTable writes the keys as a read-only linear probing table that
+// openMappedHashTable can mmap and query straight away, with no parsing or
+// rebuilding at startup. The file is position independent:
+//
+//   MappedHeader                  64 bytes
+//   MappedSlot[slotCount]         16 bytes each, slotCount a power of two
+//   key characters                poolBytes, referenced by slot offsets
+//
+// Slot offsets are relative to the start of the key characters. Each slot
+// also keeps 32 bits of the key's hash so that most mismatches are rejected
+// without touching the key pages at all.
 
-// Constants for the polynomial hash function.
-const ull MOD = 1000000007ULL;  // Large prime modulus to reduce collisions.
-const ull p = 31;              // Base value for hashing.
+const char MAPPED_MAGIC[8] = {'L', 'P', 'H', 'T', 'A', 'B', 'L', 'E'};
+const uint32_t MAPPED_VERSION = 1;
+const uint64_t MAPPED_EMPTY = ~0ULL;  // Offset of an unused slot.
+const double MAPPED_MAX_LOAD = 0.7;
 
-// Define the size of the hash table (should ideally be a prime number).
-const int TABLE_SIZE = 101;
+struct MappedHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t hashKind;      // HashKind the slots were placed with.
+    uint64_t slotCount;
+    uint64_t keyCount;
+    uint64_t poolBytes;
+    char reserved[24];      // Pads the header to 64 bytes.
+};
 
-// Computes a polynomial hash for a given string.
-// The hash is calculated as: hash(s) = Σ (s[i]-'a'+1) * p^i mod MOD.
-ull polynomialHash(const string &s) {
-    ull hash = 0;
-    ull p_pow = 1; // Represents p^0 initially.
-    for (size_t i = 0; i < s.size(); i++) {
-        int char_value = s[i] - 'a' + 1;  // Map 'a' -> 1, 'b' -> 2, etc.
-        hash = (hash + char_value * p_pow) % MOD;
-        p_pow = (p_pow * p) % MOD;
-    }
-    return hash;
-}
+struct MappedSlot {
+    uint64_t offset;        // MAPPED_EMPTY for an unused slot.
+    uint32_t length;
+    uint32_t tag;           // Folded hash of the key.
+};
 
-// Hash table structure using open addressing (linear probing).
-struct HashTable {
-    // Array of pointers to dynamically allocated std::string objects.
-    std::string **table;
-    int size;
+// A table opened with openMappedHashTable. All pointers point into the mapping.
+struct MappedHashTable {
+    void *base;
+    size_t bytes;
+    const MappedHeader *header;
+    const MappedSlot *slots;
+    const char *pool;
+    HashFunction hash;
 };
 
-// Create and initialize a hash table with a given number of buckets.
-HashTable* createHashTable(int size) {
-    HashTable* ht = new HashTable;
-    ht->size = size;
-    ht->table = new std::string*[size];
-    for (int i = 0; i < size; i++) {
-        ht->table[i] = nullptr;
-    }
-    return ht;
+uint32_t hashTag(ull hash_val) {
+    return (uint32_t)(hash_val ^ (hash_val >> 32));
 }
 
-// Insert a key into the hash table using linear probing.
-// Returns true if insertion is successful, false if the key already exists or table is full.
-bool insert(HashTable* ht, const std::string &key) {
-    ull hash_val = polynomialHash(key);
-    int index = hash_val % ht->size;
-    int start = index;
-    
-    // Loop until an empty slot is found.
-    while (ht->table[index] != nullptr) {
-        // If the key already exists, do not insert it again.
-        if (*(ht->table[index]) == key) {
-            return false;
+// Write the table to path in the mapped layout. Fails if the table's hash
+// function is not one of the families in hash_functions.h or on I/O error.
+bool saveHashTable(HashTable* ht, const char *path) {
+    HashKind kind;
+    if (!hashKindOf(ht->hash, &kind)) {
+        return false;
+    }
+
+    uint64_t slotCount = 1;
+    while (slotCount * MAPPED_MAX_LOAD < ht->count + 1) {
+        slotCount *= 2;
+    }
+
+    // Place every key; the characters follow in the same order they are visited.
+    std::vector<MappedSlot> slots(slotCount, MappedSlot{MAPPED_EMPTY, 0, 0});
+    uint64_t poolBytes = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        const KeyRef *table = (pass == 0) ? ht->table : ht->oldTable;
+        const KeyArena *arena = (pass == 0) ? &ht->arena : &ht->oldArena;
+        int size = (pass == 0) ? ht->size : ht->oldSize;
+        for (int i = 0; table != nullptr && i < size; i++) {
+            if (isEmpty(table[i])) {
+                continue;
+            }
+            ull hash_val = arenaHash(arena, table[i]);
+            uint64_t index = hash_val & (slotCount - 1);
+            while (slots[index].offset != MAPPED_EMPTY) {
+                index = (index + 1) & (slotCount - 1);
+            }
+            slots[index].offset = poolBytes;
+            slots[index].length = table[i].length;
+            slots[index].tag = hashTag(hash_val);
+            poolBytes += table[i].length;
         }
-        index = (index + 1) % ht->size;
-        // If we have looped back to the starting index, the table is full.
-        if (index == start) {
-            std::cout << "Hash table is full!" << std::endl;
-            return false;
+    }
+
+    MappedHeader header = {};
+    memcpy(header.magic, MAPPED_MAGIC, sizeof(MAPPED_MAGIC));
+    header.version = MAPPED_VERSION;
+    header.hashKind = kind;
+    header.slotCount = slotCount;
+    header.keyCount = ht->count;
+    header.poolBytes = poolBytes;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write((const char *)&header, sizeof(header));
+    out.write((const char *)slots.data(), slotCount * sizeof(MappedSlot));
+    for (int pass = 0; pass < 2; pass++) {
+        const KeyRef *table = (pass == 0) ? ht->table : ht->oldTable;
+        const KeyArena *arena = (pass == 0) ? &ht->arena : &ht->oldArena;
+        int size = (pass == 0) ? ht->size : ht->oldSize;
+        for (int i = 0; table != nullptr && i < size; i++) {
+            if (!isEmpty(table[i])) {
+                out.write(arenaKey(arena, table[i]), table[i].length);
+            }
         }
     }
-    
-    // Insert a new key.
-    ht->table[index] = new std::string(key);
-    return true;
+    out.close();
+    return !out.fail();
+}
+
+// Map a file written by saveHashTable read-only. Returns nullptr if the file
+// cannot be opened or is not a valid table.
+MappedHashTable* openMappedHashTable(const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(MappedHeader)) {
+        close(fd);
+        return nullptr;
+    }
+    size_t bytes = st.st_size;
+    void *base = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);  // The mapping stays valid after the descriptor is closed.
+    if (base == MAP_FAILED) {
+        return nullptr;
+    }
+
+    const MappedHeader *header = (const MappedHeader *)base;
+    bool valid = memcmp(header->magic, MAPPED_MAGIC, sizeof(MAPPED_MAGIC)) == 0 &&
+                 header->version == MAPPED_VERSION &&
+                 header->hashKind < HASH_KIND_COUNT &&
+                 header->slotCount != 0 &&
+                 (header->slotCount & (header->slotCount - 1)) == 0 &&
+                 header->keyCount < header->slotCount &&
+                 header->slotCount <= (bytes - sizeof(MappedHeader)) / sizeof(MappedSlot) &&
+                 sizeof(MappedHeader) + header->slotCount * sizeof(MappedSlot) + header->poolBytes == bytes;
+    if (!valid) {
+        munmap(base, bytes);
+        return nullptr;
+    }
+    // Lookups jump around the file; don't let the kernel read ahead.
+    madvise(base, bytes, MADV_RANDOM);
+
+    MappedHashTable* mt = new MappedHashTable;
+    mt->base = base;
+    mt->bytes = bytes;
+    mt->header = header;
+    mt->slots = (const MappedSlot *)((const char *)base + sizeof(MappedHeader));
+    mt->pool = (const char *)(mt->slots + header->slotCount);
+    mt->hash = hashFunction((HashKind)header->hashKind);
+    return mt;
 }
 
-// Search for a key in the hash table using linear probing.
+// Search for a key in a mapped table using linear probing.
 // Returns true if the key is found; otherwise, false.
-bool search(HashTable* ht, const std::string &key) {
-    ull hash_val = polynomialHash(key);
-    int index = hash_val % ht->size;
-    int start = index;
-    
-    while (ht->table[index] != nullptr) {
-        if (*(ht->table[index]) == key) {
-            return true;
-        }
-        index = (index + 1) % ht->size;
-        if (index == start) {  // We've searched the entire table.
+bool search(MappedHashTable* mt, const std::string &key) {
+    ull hash_val = mt->hash(key);
+    uint32_t tag = hashTag(hash_val);
+    uint64_t mask = mt->header->slotCount - 1;
+    uint64_t index = hash_val & mask;
+
+    // A table we wrote is at most 70% full, so an empty slot ends the probe;
+    // the step limit and the pool bounds check keep a damaged file from
+    // looping forever or reading past the mapping.
+    uint64_t poolBytes = mt->header->poolBytes;
+    for (uint64_t step = 0; step < mt->header->slotCount; step++) {
+        const MappedSlot &slot = mt->slots[index];
+        if (slot.offset == MAPPED_EMPTY) {
             break;
         }
+        if (slot.tag == tag && slot.length == key.size() &&
+            slot.offset <= poolBytes && slot.length <= poolBytes - slot.offset &&
+            memcmp(mt->pool + slot.offset, key.data(), key.size()) == 0) {
+            return true;
+        }
+        index = (index + 1) & mask;
     }
     return false;
 }
 
-// Free all dynamically allocated memory for the hash table.
-void deleteHashTable(HashTable* ht) {
-    for (int i = 0; i < ht->size; i++) {
-        if (ht->table[i] != nullptr) {
-            delete ht->table[i];
+void closeMappedHashTable(MappedHashTable* mt) {
+    munmap(mt->base, mt->bytes);
+    delete mt;
+}
+
+// Churn benchmark: fill the table, then run rounds of 50% inserts of fresh
+// keys and 50% deletes of random live keys at a steady key count. With
+// backward-shift deletion the probe lengths stay flat from round to round.
+void runChurnBenchmark(HashFunction hash) {
+    const int LIVE_KEYS = 200000;
+    const int ROUNDS = 10;
+    const int OPS_PER_ROUND = 1000000;
+
+    HashTable* ht = createHashTable(TABLE_SIZE, hash);
+    std::vector<std::string> live;
+    std::mt19937_64 rng(12345);
+    long long nextKey = 0;
+
+    for (int i = 0; i < LIVE_KEYS; i++) {
+        live.push_back("key" + to_string(nextKey++));
+        insert(ht, live.back());
+    }
+
+    int maxProbe;
+    double avgProbe = averageProbeLength(ht, &maxProbe);
+    cout << "Filled " << ht->count << " keys into " << ht->size << " slots, avg probe "
+         << avgProbe << ", max probe " << maxProbe << endl;
+
+    for (int round = 1; round <= ROUNDS; round++) {
+        auto start = chrono::steady_clock::now();
+        for (int op = 0; op < OPS_PER_ROUND; op++) {
+            if (op % 2 == 0) {
+                live.push_back("key" + to_string(nextKey++));
+                insert(ht, live.back());
+            } else {
+                int victim = rng() % live.size();
+                erase(ht, live[victim]);
+                live[victim] = live.back();
+                live.pop_back();
+            }
+        }
+        auto stop = chrono::steady_clock::now();
+        double ns = chrono::duration<double, nano>(stop - start).count() / OPS_PER_ROUND;
+
+        avgProbe = averageProbeLength(ht, &maxProbe);
+        cout << "Round " << round << ": " << ns << " ns/op, load "
+             << (double)ht->count / ht->size << ", avg probe " << avgProbe
+             << ", max probe " << maxProbe << endl;
+    }
+
+    deleteHashTable(ht);
+}
+
+// Churn at load: fill a table of about a million slots to one key below the
+// grow threshold, run the insert/delete mix there until dead keys set off an
+// arena compaction, then keep inserting fresh keys so the table grows while
+// the compaction is still draining. Reports the slowest single operation,
+// which resizing must keep far below a full rehash.
+void runChurnAtLoadBenchmark(HashFunction hash) {
+    const int MIN_SIZE = 1 << 20;
+    const int MAX_CHURN_OPS = 10000000;
+
+    HashTable* ht = createHashTable(TABLE_SIZE, hash);
+    std::vector<std::string> live;
+    std::mt19937_64 rng(54321);
+    long long nextKey = 0;
+
+    while (ht->size < MIN_SIZE || ht->oldTable != nullptr || ht->count + 2 <= MAX_LOAD * ht->size) {
+        live.push_back("key" + to_string(nextKey++));
+        insert(ht, live.back());
+    }
+    int startSize = ht->size;
+    cout << "Churn at load: " << ht->count << " keys in " << ht->size << " slots" << endl;
+
+    double worstNs = 0;
+    int ops = 0;
+    auto start = chrono::steady_clock::now();
+    for (; ops < MAX_CHURN_OPS && ht->oldTable == nullptr; ops++) {
+        auto opStart = chrono::steady_clock::now();
+        if (ops % 2 == 0) {
+            live.push_back("key" + to_string(nextKey++));
+            insert(ht, live.back());
+        } else {
+            int victim = rng() % live.size();
+            erase(ht, live[victim]);
+            live[victim] = live.back();
+            live.pop_back();
         }
+        worstNs = max(worstNs, chrono::duration<double, nano>(chrono::steady_clock::now() - opStart).count());
+    }
+    int churnOps = ops;
+    int growOps = startSize / 2;
+    for (int i = 0; i < growOps; i++, ops++) {
+        auto opStart = chrono::steady_clock::now();
+        insert(ht, "key" + to_string(nextKey++));
+        worstNs = max(worstNs, chrono::duration<double, nano>(chrono::steady_clock::now() - opStart).count());
+    }
+    auto stop = chrono::steady_clock::now();
+
+    cout << "  " << churnOps << " churn ops until compaction, then " << growOps << " inserts: "
+         << chrono::duration<double, nano>(stop - start).count() / ops << " ns/op, final size "
+         << ht->size << ", worst op " << worstNs / 1000 << " us" << endl;
+    deleteHashTable(ht);
+}
+
+// Compare one-at-a-time search with searchBatch on a table too large for
+// the cache, probing a mix of present and absent keys.
+void runBatchBenchmark() {
+    const int KEYS = 1 << 21;
+    const int LOOKUPS = 1 << 22;
+
+    HashTable* ht = createHashTable(TABLE_SIZE, mixHash);
+    for (int i = 0; i < KEYS; i++) {
+        insert(ht, "key" + to_string(i));
+    }
+
+    std::mt19937_64 rng(7);
+    std::vector<std::string> lookups(LOOKUPS);
+    for (int i = 0; i < LOOKUPS; i++) {
+        lookups[i] = "key" + to_string(rng() % (2 * KEYS));
+    }
+    bool *found = new bool[LOOKUPS];
+
+    auto start = chrono::steady_clock::now();
+    int hits = 0;
+    for (int i = 0; i < LOOKUPS; i++) {
+        hits += search(ht, lookups[i]);
     }
-    delete[] ht->table;
-    delete ht;
+    auto mid = chrono::steady_clock::now();
+    searchBatch(ht, lookups.data(), LOOKUPS, found);
+    auto stop = chrono::steady_clock::now();
+
+    int batchHits = 0;
+    for (int i = 0; i < LOOKUPS; i++) {
+        batchHits += found[i];
+    }
+    cout << "search:      " << chrono::duration<double, nano>(mid - start).count() / LOOKUPS
+         << " ns/lookup, " << hits << " hits" << endl;
+    cout << "searchBatch: " << chrono::duration<double, nano>(stop - mid).count() / LOOKUPS
+         << " ns/lookup, " << batchHits << " hits" << endl;
+
+    delete[] found;
+    deleteHashTable(ht);
+}
+
+// Insert n generated keys and report the build time, the peak resident set
+// size and the table's own bytes per key (slots plus arena).
+void runLoadBenchmark(long long n) {
+    HashTable* ht = createHashTable(TABLE_SIZE, mixHash);
+    auto start = chrono::steady_clock::now();
+    for (long long i = 0; i < n; i++) {
+        insert(ht, "key" + to_string(i));
+    }
+    auto stop = chrono::steady_clock::now();
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    double tableBytes = (double)ht->size * sizeof(KeyRef) + ht->arena.capacity +
+                        (double)ht->oldSize * sizeof(KeyRef) + ht->oldArena.capacity;
+    cout << "keys " << ht->count << ", build " << chrono::duration<double>(stop - start).count()
+         << " s, peak RSS " << usage.ru_maxrss / 1024 << " MB, "
+         << tableBytes / max(ht->count, 1) << " bytes/key" << endl;
+    deleteHashTable(ht);
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // "churn [polynomial|mix|crc32c]" runs the benchmark with the chosen hash.
+    if (argc > 1 && string(argv[1]) == "churn") {
+        HashKind kind = HASH_POLYNOMIAL;
+        if (argc > 2 && !hashKindFromName(argv[2], &kind)) {
+            cout << "Unknown hash function: " << argv[2] << endl;
+            return 1;
+        }
+        runChurnBenchmark(hashFunction(kind));
+        runChurnAtLoadBenchmark(hashFunction(kind));
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "batch") {
+        runBatchBenchmark();
+        return 0;
+    }
+    // "load N" inserts N keys and reports build time and memory use.
+    if (argc > 2 && string(argv[1]) == "load") {
+        runLoadBenchmark(atoll(argv[2]));
+        return 0;
+    }
+    // "save FILE" builds a table from the lines of stdin and writes it to FILE.
+    if (argc > 2 && string(argv[1]) == "save") {
+        HashTable* ht = createHashTable(TABLE_SIZE, mixHash);
+        std::string line;
+        while (getline(cin, line)) {
+            insert(ht, line);
+        }
+        bool saved = saveHashTable(ht, argv[2]);
+        cout << (saved ? "Saved " : "Could not save ") << ht->count << " keys to " << argv[2] << endl;
+        deleteHashTable(ht);
+        return saved ? 0 : 1;
+    }
+    // "query FILE KEY..." maps a saved table and looks up each KEY.
+    if (argc > 2 && string(argv[1]) == "query") {
+        MappedHashTable* mt = openMappedHashTable(argv[2]);
+        if (mt == nullptr) {
+            cout << "Could not open hash table file " << argv[2] << endl;
+            return 1;
+        }
+        for (int i = 3; i < argc; i++) {
+            cout << argv[i] << ": " << (search(mt, argv[i]) ? "found" : "NOT found") << endl;
+        }
+        closeMappedHashTable(mt);
+        return 0;
+    }
+
     HashTable* ht = createHashTable(TABLE_SIZE);
     
     int n;
@@ -0,0 +1,337 @@
+#ifndef LINEAR_PROBE_H
+#define LINEAR_PROBE_H
+
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include "hash_functions.h"
+#include "key_arena.h"
+
+// Open-addressing hash table of strings with linear probing, backward-shift
+// deletion and incremental resizing. The demo and benchmark program is
+// linear_probe.cpp; hash_table_bench.cpp compares it with the other tables.
+
+namespace linear {
+
+// Initial size of the hash table (should ideally be a prime number).
+// The table grows on its own once it fills up.
+const int TABLE_SIZE = 101;
+
+// Grow once the table is more than three quarters full.
+const double MAX_LOAD = 0.75;
+
+// Number of old buckets moved into the new table by each insert or search
+// while a resize is in progress. This bounds the work any single call does.
+const int REHASH_STEP = 8;
+
+// Erased keys leave their characters behind in the arena. Once those dead
+// bytes outweigh the live ones (and the arena is at least this large), the
+// table is rebuilt, which copies only live keys. The rebuild keeps the same
+// size unless the table is too close to MAX_LOAD for it to finish draining
+// before the next grow; then it grows instead.
+const uint64_t COMPACT_MIN_BYTES = 1 << 16;
+
+// Hash table structure using open addressing (linear probing).
+// Slots are 8-byte references into a KeyArena (key_arena.h) that holds the
+// characters and hash of every key.
+// Growing allocates a table of about twice the size and then drains the old
+// one a few buckets per operation, so no call pays for a full rehash. Empty
+// slots are all zero bytes, so the new table comes from calloc and its pages
+// are zeroed by the OS as they are first touched rather than all at once by
+// the insert that starts the resize.
+// A key lives in exactly one of the two tables, and each table has its own
+// arena: draining copies the live keys into the new arena and the old arena
+// is freed in one go when the last bucket has moved.
+struct HashTable {
+    KeyRef *table;
+    int size;
+    int count;              // Number of distinct keys stored.
+    HashFunction hash;      // Chosen when the table is created.
+    KeyArena arena;         // Keys referenced by `table`.
+    uint64_t liveBytes;     // Bytes of `arena` still referenced by `table`.
+    // Table being drained into `table`, or nullptr when no resize is running.
+    KeyRef *oldTable;
+    int oldSize;
+    int migrateIndex;       // Next bucket of oldTable to move.
+    KeyArena oldArena;      // Keys referenced by `oldTable`.
+};
+
+// A table of size empty slots; release it with free.
+inline KeyRef* allocateSlots(int size) {
+    KeyRef *table = (KeyRef *)calloc(size, sizeof(KeyRef));
+    if (table == nullptr) {
+        throw std::bad_alloc();
+    }
+    return table;
+}
+
+// Create and initialize a hash table with a given number of buckets.
+inline HashTable* createHashTable(int size, HashFunction hash = polynomialHash) {
+    HashTable* ht = new HashTable;
+    ht->size = size;
+    ht->count = 0;
+    ht->hash = hash;
+    ht->table = allocateSlots(size);
+    initArena(&ht->arena);
+    ht->liveBytes = 0;
+    ht->oldTable = nullptr;
+    ht->oldSize = 0;
+    ht->migrateIndex = 0;
+    initArena(&ht->oldArena);
+    return ht;
+}
+
+// Linear probe for key in one bucket array; returns its index or -1.
+inline int findIndex(const KeyRef *table, int size, const KeyArena *arena, const std::string &key, ull hash_val) {
+    int index = hash_val % size;
+    int start = index;
+
+    while (!isEmpty(table[index])) {
+        if (keyEquals(arena, table[index], key, hash_val)) {
+            return index;
+        }
+        index = (index + 1) % size;
+        if (index == start) {  // We've searched the entire table.
+            break;
+        }
+    }
+    return -1;
+}
+
+// Put a stored key into the first free slot of its probe sequence.
+// The caller guarantees the key is absent and that a free slot exists.
+inline void placeKey(KeyRef *table, int size, KeyRef ref, ull hash_val) {
+    int index = hash_val % size;
+    while (!isEmpty(table[index])) {
+        index = (index + 1) % size;
+    }
+    table[index] = ref;
+}
+
+// Empty slot `hole` without leaving a tombstone (backward-shift deletion).
+// Later keys of the same cluster are pulled back into the hole whenever that
+// does not move them in front of their home slot, so every remaining key is
+// still reachable from its home without crossing an empty slot.
+inline void shiftBackward(KeyRef *table, int size, const KeyArena *arena, int hole) {
+    int index = hole;
+    while (true) {
+        index = (index + 1) % size;
+        if (isEmpty(table[index])) {
+            break;
+        }
+        int home = arenaHash(arena, table[index]) % size;
+        // The key may move to the hole unless its home lies cyclically in (hole, index].
+        bool homeAfterHole = (hole <= index) ? (home > hole && home <= index)
+                                             : (home > hole || home <= index);
+        if (!homeAfterHole) {
+            table[hole] = table[index];
+            hole = index;
+        }
+    }
+    table[hole] = EMPTY_REF;
+}
+
+// Move up to REHASH_STEP buckets of the old table into the current one,
+// releasing the old bucket array and arena once the last bucket has been moved.
+// Moved keys are removed from the old table by backward shift, which keeps
+// it a valid probing table that holds only the keys not yet moved. A shift
+// can pull a later key into the current bucket, so the index only advances
+// once the bucket is empty.
+inline void migrateStep(HashTable* ht) {
+    if (ht->oldTable == nullptr) {
+        return;
+    }
+    for (int moved = 0; moved < REHASH_STEP && ht->migrateIndex < ht->oldSize; moved++) {
+        KeyRef ref = ht->oldTable[ht->migrateIndex];
+        if (isEmpty(ref)) {
+            ht->migrateIndex++;
+            continue;
+        }
+        ull hash_val = arenaHash(&ht->oldArena, ref);
+        KeyRef copy = arenaAppend(&ht->arena, arenaKey(&ht->oldArena, ref), ref.length, hash_val);
+        ht->liveBytes += recordSize(ref.length);
+        placeKey(ht->table, ht->size, copy, hash_val);
+        shiftBackward(ht->oldTable, ht->oldSize, &ht->oldArena, ht->migrateIndex);
+    }
+    if (ht->migrateIndex == ht->oldSize) {
+        free(ht->oldTable);
+        freeArena(&ht->oldArena);
+        ht->oldTable = nullptr;
+        ht->oldSize = 0;
+        ht->migrateIndex = 0;
+    }
+}
+
+// Start moving the keys into a table of newSize buckets and a fresh arena.
+// The move itself is spread over the following operations by migrateStep.
+inline void beginResize(HashTable* ht, int newSize) {
+    // A resize drains faster than the new table can fill up, but finish any
+    // straggler so there is never more than one old table.
+    while (ht->oldTable != nullptr) {
+        migrateStep(ht);
+    }
+    ht->oldTable = ht->table;
+    ht->oldSize = ht->size;
+    ht->oldArena = ht->arena;
+    ht->migrateIndex = 0;
+    ht->size = newSize;
+    ht->table = allocateSlots(newSize);
+    initArena(&ht->arena);
+    ht->liveBytes = 0;
+}
+
+// Insert a key into the hash table using linear probing.
+// Returns true if insertion is successful, false if the key already exists
+// or is longer than MAX_KEY_LENGTH.
+inline bool insert(HashTable* ht, const std::string &key) {
+    if (key.size() > MAX_KEY_LENGTH) {
+        return false;
+    }
+    migrateStep(ht);
+    ull hash_val = ht->hash(key);
+
+    // If the key already exists, do not insert it again.
+    if (findIndex(ht->table, ht->size, &ht->arena, key, hash_val) != -1) {
+        return false;
+    }
+    if (ht->oldTable != nullptr &&
+        findIndex(ht->oldTable, ht->oldSize, &ht->oldArena, key, hash_val) != -1) {
+        return false;
+    }
+
+    if (ht->count + 1 > MAX_LOAD * ht->size) {
+        beginResize(ht, 2 * ht->size + 1);
+    }
+
+    // Insert a new key.
+    placeKey(ht->table, ht->size, arenaAppend(&ht->arena, key.data(), key.size(), hash_val), hash_val);
+    ht->liveBytes += recordSize(key.size());
+    ht->count++;
+    return true;
+}
+
+// Search for a key in the hash table using linear probing.
+// Returns true if the key is found; otherwise, false.
+inline bool search(HashTable* ht, const std::string &key) {
+    migrateStep(ht);
+    ull hash_val = ht->hash(key);
+
+    if (findIndex(ht->table, ht->size, &ht->arena, key, hash_val) != -1) {
+        return true;
+    }
+    // Keys not yet moved are still reachable through the old table.
+    return ht->oldTable != nullptr &&
+           findIndex(ht->oldTable, ht->oldSize, &ht->oldArena, key, hash_val) != -1;
+}
+
+// Number of lookups searchBatch keeps in flight at once.
+const int BATCH_WINDOW = 16;
+
+// Look up n keys at once; found[i] is set to whether keys[i] is present.
+// Keys are handled BATCH_WINDOW at a time: first every hash is computed and
+// its home slot prefetched, then the arena records those slots refer to,
+// and only then is each probe resolved. The cache misses of a whole window
+// overlap instead of being paid one after another.
+inline void searchBatch(HashTable* ht, const std::string *keys, int n, bool *found) {
+    ull hashes[BATCH_WINDOW];
+    for (int base = 0; base < n; base += BATCH_WINDOW) {
+        int count = std::min(BATCH_WINDOW, n - base);
+        // The same migration work that count calls to search() would do.
+        for (int i = 0; i < count; i++) {
+            migrateStep(ht);
+        }
+
+        for (int i = 0; i < count; i++) {
+            hashes[i] = ht->hash(keys[base + i]);
+            __builtin_prefetch(&ht->table[hashes[i] % ht->size]);
+            if (ht->oldTable != nullptr) {
+                __builtin_prefetch(&ht->oldTable[hashes[i] % ht->oldSize]);
+            }
+        }
+        for (int i = 0; i < count; i++) {
+            KeyRef slot = ht->table[hashes[i] % ht->size];
+            if (!isEmpty(slot)) {
+                __builtin_prefetch(arenaRecord(&ht->arena, slot));
+            }
+        }
+
+        for (int i = 0; i < count; i++) {
+            const std::string &key = keys[base + i];
+            found[base + i] =
+                findIndex(ht->table, ht->size, &ht->arena, key, hashes[i]) != -1 ||
+                (ht->oldTable != nullptr &&
+                 findIndex(ht->oldTable, ht->oldSize, &ht->oldArena, key, hashes[i]) != -1);
+        }
+    }
+}
+
+// Remove a key from the hash table using backward-shift deletion.
+// Returns true if the key was present.
+inline bool erase(HashTable* ht, const std::string &key) {
+    migrateStep(ht);
+    ull hash_val = ht->hash(key);
+
+    int index = findIndex(ht->table, ht->size, &ht->arena, key, hash_val);
+    if (index != -1) {
+        ht->liveBytes -= recordSize(ht->table[index].length);
+        shiftBackward(ht->table, ht->size, &ht->arena, index);
+    } else if (ht->oldTable != nullptr &&
+               (index = findIndex(ht->oldTable, ht->oldSize, &ht->oldArena, key, hash_val)) != -1) {
+        // The old arena is freed whole once the migration finishes.
+        shiftBackward(ht->oldTable, ht->oldSize, &ht->oldArena, index);
+    } else {
+        return false;
+    }
+    ht->count--;
+
+    if (ht->oldTable == nullptr && ht->arena.used > COMPACT_MIN_BYTES &&
+        ht->arena.used - ht->liveBytes > ht->liveBytes) {
+        // Draining visits every bucket once and moves every key once, at
+        // REHASH_STEP per operation, and each insert adds at most one key.
+        int drainOps = (ht->size + ht->count) / REHASH_STEP + 1;
+        if (ht->count + drainOps <= MAX_LOAD * ht->size) {
+            beginResize(ht, ht->size);
+        } else {
+            beginResize(ht, 2 * ht->size + 1);
+        }
+    }
+    return true;
+}
+
+// Average number of slots a successful search inspects, and the longest
+// such probe, taken over every key currently stored.
+inline double averageProbeLength(HashTable* ht, int *maxProbe) {
+    long long total = 0;
+    *maxProbe = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        const KeyRef *table = (pass == 0) ? ht->table : ht->oldTable;
+        const KeyArena *arena = (pass == 0) ? &ht->arena : &ht->oldArena;
+        int size = (pass == 0) ? ht->size : ht->oldSize;
+        for (int i = 0; table != nullptr && i < size; i++) {
+            if (isEmpty(table[i])) {
+                continue;
+            }
+            int home = arenaHash(arena, table[i]) % size;
+            int probe = (i - home + size) % size + 1;
+            total += probe;
+            if (probe > *maxProbe) {
+                *maxProbe = probe;
+            }
+        }
+    }
+    return ht->count == 0 ? 0.0 : (double)total / ht->count;
+}
+
+// Free all dynamically allocated memory for the hash table.
+// The keys go with their arenas; nothing is freed per key.
+inline void deleteHashTable(HashTable* ht) {
+    free(ht->table);
+    free(ht->oldTable);
+    freeArena(&ht->arena);
+    freeArena(&ht->oldArena);
+    delete ht;
+}
+
+}  // namespace linear
+
+#endif
\ No newline at end of file
@@ -0,0 +1,301 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include "hash_functions.h"
+
+using namespace std;
+
+// Minimal perfect hashing for key sets that never change after loading
+// (PTHash style). Every key is hashed once with a seeded mixHash. The hash
+// picks a bucket, and each bucket stores a small "pilot" chosen at build time
+// so that (hash ^ scramble(pilot)) mod tableSize sends every key to its own
+// position. Positions at or above n are folded back into the free positions
+// below n, so the n keys land in slots 0..n-1 with no gaps and a lookup
+// inspects exactly one slot.
+//
+// The function itself costs 16 bits per bucket plus 32 bits per folded
+// position, about 4-5 bits per key. The keys are kept next to it so that
+// search can tell members from non-members.
+
+const double LOAD_FACTOR = 0.98;    // n / tableSize before folding.
+const double BUCKET_FACTOR = 5.0;   // Buckets = BUCKET_FACTOR * n / log2(n).
+const int MAX_PILOT = 65535;        // Pilots are stored in 16 bits.
+const int MAX_ATTEMPTS = 32;        // Seeds tried before giving up.
+
+// Keys are spread unevenly over buckets: 60% of them go to the first 30% of
+// buckets. Placing the crowded buckets first, while most slots are free,
+// keeps the pilot search short for everything that follows.
+const double DENSE_KEY_SHARE = 0.6;
+const double DENSE_BUCKET_SHARE = 0.3;
+
+struct PerfectHash {
+    int keyCount;
+    uint64_t tableSize;
+    uint64_t bucketCount;
+    uint64_t denseBuckets;
+    ull seed;
+    uint16_t *pilots;       // One per bucket.
+    uint32_t *remap;        // remap[p - keyCount] for positions p >= keyCount.
+    uint64_t *offsets;      // Key in slot i is pool[offsets[i] .. offsets[i + 1]).
+    char *pool;
+};
+
+// Map a 64-bit value uniformly onto [0, range) without a division.
+uint64_t scaleToRange(ull value, uint64_t range) {
+    return (uint64_t)(((unsigned __int128)value * range) >> 64);
+}
+
+uint64_t bucketOf(const PerfectHash *ph, ull hash_val) {
+    // The low half of the hash decides dense or sparse, the high half the bucket.
+    ull selector = hash_val << 32;
+    if (selector < (ull)(DENSE_KEY_SHARE * 18446744073709551615.0) ||
+        ph->denseBuckets == ph->bucketCount) {
+        return scaleToRange(hash_val, ph->denseBuckets);
+    }
+    return ph->denseBuckets + scaleToRange(hash_val, ph->bucketCount - ph->denseBuckets);
+}
+
+// Position of a key (before folding) for a given pilot of its bucket.
+uint64_t positionOf(const PerfectHash *ph, ull hash_val, int pilot) {
+    ull scrambled = multiplyMix((ull)pilot + 1, MIX_SECRET2 ^ ph->seed);
+    return (hash_val ^ scrambled) % ph->tableSize;
+}
+
+// Try to place every key with one seed. Returns false if some bucket finds
+// no pilot or two different keys share a full 64-bit hash; the caller then
+// retries with another seed.
+bool tryBuild(PerfectHash *ph, const std::vector<std::string> &keys, std::vector<uint64_t> &slotOf) {
+    int n = keys.size();
+    std::vector<ull> hashes(n);
+    for (int i = 0; i < n; i++) {
+        hashes[i] = mixHashBytes(keys[i].data(), keys[i].size(), ph->seed);
+    }
+
+    // Group keys by bucket with a counting sort.
+    std::vector<uint32_t> bucketStart(ph->bucketCount + 1, 0);
+    std::vector<uint64_t> bucketOfKey(n);
+    for (int i = 0; i < n; i++) {
+        bucketOfKey[i] = bucketOf(ph, hashes[i]);
+        bucketStart[bucketOfKey[i] + 1]++;
+    }
+    for (uint64_t b = 0; b < ph->bucketCount; b++) {
+        bucketStart[b + 1] += bucketStart[b];
+    }
+    std::vector<uint32_t> members(n);
+    std::vector<uint32_t> fill(bucketStart.begin(), bucketStart.end() - 1);
+    for (int i = 0; i < n; i++) {
+        members[fill[bucketOfKey[i]]++] = i;
+    }
+
+    // Largest buckets first.
+    std::vector<uint32_t> order(ph->bucketCount);
+    for (uint64_t b = 0; b < ph->bucketCount; b++) {
+        order[b] = b;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return bucketStart[a + 1] - bucketStart[a] > bucketStart[b + 1] - bucketStart[b];
+    });
+
+    std::vector<bool> taken(ph->tableSize, false);
+    std::vector<uint64_t> positions;
+    for (uint32_t bucket : order) {
+        uint32_t first = bucketStart[bucket], last = bucketStart[bucket + 1];
+        if (first == last) {
+            ph->pilots[bucket] = 0;
+            continue;
+        }
+        bool placed = false;
+        for (int pilot = 0; pilot <= MAX_PILOT && !placed; pilot++) {
+            positions.clear();
+            bool ok = true;
+            for (uint32_t k = first; k < last && ok; k++) {
+                uint64_t pos = positionOf(ph, hashes[members[k]], pilot);
+                ok = !taken[pos] && std::find(positions.begin(), positions.end(), pos) == positions.end();
+                positions.push_back(pos);
+            }
+            if (!ok) {
+                continue;
+            }
+            for (uint32_t k = first; k < last; k++) {
+                taken[positions[k - first]] = true;
+                slotOf[members[k]] = positions[k - first];
+            }
+            ph->pilots[bucket] = pilot;
+            placed = true;
+        }
+        if (!placed) {
+            return false;
+        }
+    }
+
+    // Fold positions >= n onto the free positions below n, in order.
+    // Unused positions fold onto slot 0; only non-members can land there,
+    // and the key compare turns them away.
+    uint64_t freeSlot = 0;
+    for (uint64_t pos = n; pos < ph->tableSize; pos++) {
+        if (!taken[pos]) {
+            ph->remap[pos - n] = 0;
+            continue;
+        }
+        while (taken[freeSlot]) {
+            freeSlot++;
+        }
+        ph->remap[pos - n] = freeSlot++;
+    }
+    for (int i = 0; i < n; i++) {
+        if (slotOf[i] >= (uint64_t)n) {
+            slotOf[i] = ph->remap[slotOf[i] - n];
+        }
+    }
+    return true;
+}
+
+// Build a minimal perfect hash over n keys. Duplicate keys are stored once.
+// Returns nullptr if no seed produced a valid function (practically never).
+PerfectHash* buildPerfectHash(const std::string *input, int n) {
+    std::vector<std::string> keys(input, input + n);
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    n = keys.size();
+
+    PerfectHash* ph = new PerfectHash;
+    ph->keyCount = n;
+    ph->tableSize = std::max<uint64_t>(1, (uint64_t)std::ceil(n / LOAD_FACTOR));
+    double logN = std::max(1.0, std::log2((double)n));
+    ph->bucketCount = std::max<uint64_t>(1, (uint64_t)std::ceil(BUCKET_FACTOR * n / logN));
+    ph->denseBuckets = std::max<uint64_t>(1, (uint64_t)(DENSE_BUCKET_SHARE * ph->bucketCount));
+    if (ph->denseBuckets >= ph->bucketCount) {
+        ph->denseBuckets = ph->bucketCount;
+    }
+    ph->pilots = new uint16_t[ph->bucketCount];
+    ph->remap = new uint32_t[ph->tableSize - n];
+
+    std::vector<uint64_t> slotOf(n);
+    bool built = false;
+    for (int attempt = 0; attempt < MAX_ATTEMPTS && !built; attempt++) {
+        ph->seed = multiplyMix(attempt + 1, MIX_SECRET3);
+        built = tryBuild(ph, keys, slotOf);
+    }
+    if (!built) {
+        delete[] ph->pilots;
+        delete[] ph->remap;
+        delete ph;
+        return nullptr;
+    }
+
+    // Store the keys in slot order so a lookup lands directly on its key.
+    std::vector<int> keyInSlot(n);
+    for (int i = 0; i < n; i++) {
+        keyInSlot[slotOf[i]] = i;
+    }
+    ph->offsets = new uint64_t[n + 1];
+    ph->offsets[0] = 0;
+    for (int s = 0; s < n; s++) {
+        ph->offsets[s + 1] = ph->offsets[s] + keys[keyInSlot[s]].size();
+    }
+    ph->pool = new char[ph->offsets[n] + 1];
+    for (int s = 0; s < n; s++) {
+        memcpy(ph->pool + ph->offsets[s], keys[keyInSlot[s]].data(), keys[keyInSlot[s]].size());
+    }
+    return ph;
+}
+
+// Slot of key in [0, n) if it is one of the build keys, otherwise -1.
+int lookupIndex(PerfectHash* ph, const std::string &key) {
+    if (ph->keyCount == 0) {
+        return -1;
+    }
+    ull hash_val = mixHashBytes(key.data(), key.size(), ph->seed);
+    uint64_t pos = positionOf(ph, hash_val, ph->pilots[bucketOf(ph, hash_val)]);
+    if (pos >= (uint64_t)ph->keyCount) {
+        pos = ph->remap[pos - ph->keyCount];
+    }
+    uint64_t length = ph->offsets[pos + 1] - ph->offsets[pos];
+    if (length != key.size() || memcmp(ph->pool + ph->offsets[pos], key.data(), length) != 0) {
+        return -1;
+    }
+    return (int)pos;
+}
+
+// Search for a key; returns true if it was in the build set.
+bool search(PerfectHash* ph, const std::string &key) {
+    return lookupIndex(ph, key) != -1;
+}
+
+// Bits per key used by the hash function itself (pilots and fold table).
+double functionBitsPerKey(PerfectHash* ph) {
+    if (ph->keyCount == 0) {
+        return 0.0;
+    }
+    double bits = 16.0 * ph->bucketCount + 32.0 * (ph->tableSize - ph->keyCount);
+    return bits / ph->keyCount;
+}
+
+void deletePerfectHash(PerfectHash* ph) {
+    delete[] ph->pilots;
+    delete[] ph->remap;
+    delete[] ph->offsets;
+    delete[] ph->pool;
+    delete ph;
+}
+
+int main(int argc, char* argv[]) {
+    // "stats N" builds a function over N generated keys and reports its cost.
+    if (argc > 2 && string(argv[1]) == "stats") {
+        int n = atoi(argv[2]);
+        std::vector<std::string> keys(n);
+        for (int i = 0; i < n; i++) {
+            keys[i] = "key" + to_string(i);
+        }
+        auto start = chrono::steady_clock::now();
+        PerfectHash* ph = buildPerfectHash(keys.data(), n);
+        auto built = chrono::steady_clock::now();
+        if (ph == nullptr) {
+            cout << "Build failed." << endl;
+            return 1;
+        }
+        int hits = 0;
+        for (int i = 0; i < n; i++) {
+            hits += search(ph, keys[i]);
+        }
+        auto stop = chrono::steady_clock::now();
+        cout << "keys " << n << ", build " << chrono::duration<double>(built - start).count()
+             << " s, " << functionBitsPerKey(ph) << " bits/key, "
+             << chrono::duration<double, nano>(stop - built).count() / max(n, 1)
+             << " ns/lookup, " << hits << " found" << endl;
+        deletePerfectHash(ph);
+        return 0;
+    }
+
+    int n;
+    cout << "Enter number of strings to insert: ";
+    cin >> n;
+    cin.ignore();  // Clear newline from the input buffer.
+
+    std::vector<std::string> keys(n);
+    for (int i = 0; i < n; i++) {
+        cout << "Enter string " << i + 1 << ": ";
+        getline(cin, keys[i]);
+    }
+    PerfectHash* ph = buildPerfectHash(keys.data(), n);
+    if (ph == nullptr) {
+        cout << "Could not build a perfect hash for these strings." << endl;
+        return 1;
+    }
+
+    std::string input;
+    cout << "\nEnter string to search: ";
+    getline(cin, input);
+    if (search(ph, input))
+        cout << "String found in the hash table." << endl;
+    else
+        cout << "String NOT found in the hash table." << endl;
+
+    deletePerfectHash(ph);
+    return 0;
+}
\ No newline at end of file
@@ -1,104 +1,54 @@
 #include <iostream>
 #include <string>
+#include <algorithm>
+#include "hash_functions.h"
+#include "quad_probe.h"
 
 using namespace std;
-typedef unsigned long long ull;
+using namespace quadratic;
 
-// Constants for polynomial hashing
-const ull MOD = 1000000007ULL;  // A large prime modulus
-const ull p = 31;              // Base value for hashing
-
-// Size of the hash table (preferably a prime number for better distribution)
-const int TABLE_SIZE = 101;
-
-// Compute a polynomial hash for the given string.
-// Each character (assumed lowercase) is mapped to (s[i]-'a'+1) and contributes as:
-// hash(s) = sum_{i=0}^{n-1} (s[i]-'a'+1) * p^i mod MOD.
-ull polynomialHash(const string &s) {
-    ull hash = 0;
-    ull p_pow = 1; // Represents p^0 initially.
-    for (size_t i = 0; i < s.size(); i++) {
-        int char_value = s[i] - 'a' + 1;
-        hash = (hash + char_value * p_pow) % MOD;
-        p_pow = (p_pow * p) % MOD;
-    }
-    return hash;
-}
-
-// Hash table structure using open addressing with quadratic probing.
-struct HashTable {
-    // Array of pointers to std::string (dynamically allocated keys)
-    std::string **table;
-    int size;
-};
-
-// Create and initialize a hash table with a given number of buckets.
-HashTable* createHashTable(int size) {
-    HashTable* ht = new HashTable;
-    ht->size = size;
-    ht->table = new std::string*[size];
-    for (int i = 0; i < size; i++) {
-        ht->table[i] = nullptr;
-    }
-    return ht;
-}
-
-// Insert a key into the hash table using quadratic probing.
-// Returns true if insertion is successful, or false if the key already exists or table is full.
-bool insert(HashTable* ht, const std::string &key) {
-    ull hash_val = polynomialHash(key);
-    
-    // Quadratic probing: try indices (hash + i + i^2) mod table_size.
-    for (int i = 0; i < ht->size; i++) {
-        int index = (hash_val + i + i * i) % ht->size;
-        
-        // If the slot is empty, insert the key.
-        if (ht->table[index] == nullptr) {
-            ht->table[index] = new std::string(key);
-            return true;
-        }
-        // If the key is already present, do not insert it again.
-        if (*(ht->table[index]) == key) {
-            return false;
+// Print the histogram as "probes: keys" lines followed by a summary.
+void printProbeStats(ProbeStats* stats) {
+    for (int d = 0; d < stats->maxProbe; d++) {
+        if (stats->histogram[d] != 0) {
+            cout << "  " << d + 1 << " probe(s): " << stats->histogram[d] << endl;
         }
     }
-    
-    // If we exit the loop, the table is full.
-    std::cout << "Hash table is full!" << std::endl;
-    return false;
+    cout << "  keys " << stats->keys << ", avg probe " << stats->averageProbe
+         << ", max probe " << stats->maxProbe << endl;
 }
 
-// Search for a key in the hash table using quadratic probing.
-// Returns true if the key is found; otherwise, false.
-bool search(HashTable* ht, const std::string &key) {
-    ull hash_val = polynomialHash(key);
-    
-    for (int i = 0; i < ht->size; i++) {
-        int index = (hash_val + i + i * i) % ht->size;
-        
-        // If an empty slot is found, the key is not in the table.
-        if (ht->table[index] == nullptr) {
-            return false;
-        }
-        if (*(ht->table[index]) == key) {
-            return true;
+// Fill a plain and a Robin Hood table right up to their growth thresholds
+// and print the probe-length distribution of each.
+void runProbeStats(HashFunction hash) {
+    const int SLOTS = 1 << 20;
+    for (int mode = 0; mode < 2; mode++) {
+        HashTable* ht = createHashTable(SLOTS, mode == 1, hash);
+        int keys = (int)(ht->maxLoad * SLOTS);
+        for (int i = 0; i < keys; i++) {
+            insert(ht, "key" + to_string(i));
         }
+        cout << (mode == 1 ? "Robin Hood" : "Quadratic") << " probing at load "
+             << (double)ht->count / ht->size << ":" << endl;
+        ProbeStats* stats = getProbeStats(ht);
+        printProbeStats(stats);
+        deleteProbeStats(stats);
+        deleteHashTable(ht);
     }
-    return false;
 }
 
-// Free all dynamically allocated memory for the hash table.
-void deleteHashTable(HashTable* ht) {
-    for (int i = 0; i < ht->size; i++) {
-        if (ht->table[i] != nullptr) {
-            delete ht->table[i];
+int main(int argc, char* argv[]) {
+    // "stats [polynomial|mix|crc32c]" reports probe lengths with the chosen hash.
+    if (argc > 1 && string(argv[1]) == "stats") {
+        HashKind kind = HASH_POLYNOMIAL;
+        if (argc > 2 && !hashKindFromName(argv[2], &kind)) {
+            cout << "Unknown hash function: " << argv[2] << endl;
+            return 1;
         }
+        runProbeStats(hashFunction(kind));
+        return 0;
     }
-    delete[] ht->table;
-    delete ht;
-}
 
-int main() {
     HashTable* ht = createHashTable(TABLE_SIZE);
     
     int n;
@@ -0,0 +1,333 @@
+#ifndef QUAD_PROBE_H
+#define QUAD_PROBE_H
+
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include "hash_functions.h"
+#include "key_arena.h"
+
+// Open-addressing hash table of strings with quadratic probing and an
+// optional Robin Hood mode. The demo and statistics program is
+// quad_probe.cpp; hash_table_bench.cpp compares it with the other tables.
+
+namespace quadratic {
+
+// Initial size of the hash table. It is rounded up to a power of two and
+// the table grows on its own once it fills up.
+const int TABLE_SIZE = 101;
+
+// Grow once the table is more than three quarters full, or 90% full in
+// Robin Hood mode, where probe lengths stay short at higher load.
+const double MAX_LOAD = 0.75;
+const double ROBIN_HOOD_MAX_LOAD = 0.9;
+
+// Number of old buckets moved into the new table by each insert or search
+// while a resize is in progress. This bounds the work any single call does.
+const int REHASH_STEP = 8;
+
+// Hash table structure using open addressing with quadratic probing.
+// The size is always a power of two and probe i lands at hash + i(i+1)/2,
+// which visits every slot once, so an insert always finds a free slot.
+// Growing allocates a table of twice the size and then drains the old one a
+// few buckets per operation, so no call pays for a full rehash. Both arrays
+// of the new table come zeroed from calloc, which is what an empty slot
+// looks like, so the resizing insert does not write them out either.
+// Keys are never removed, so both tables refer into one KeyArena
+// (key_arena.h) and a resize moves only the 8-byte slot references.
+//
+// In Robin Hood mode an insert that meets a key closer to its home than the
+// new key is to its own takes that slot and carries on inserting the evicted
+// key instead. This evens out probe lengths, lets a search stop as soon as
+// it meets a key closer to home than the one it is looking for, and keeps
+// lookups short enough to run the table at 0.9 load.
+struct HashTable {
+    KeyRef *table;
+    // dist[i] is the probe number (0 = home slot) at which table[i] sits.
+    int *dist;
+    int size;
+    int count;              // Number of distinct keys stored.
+    HashFunction hash;      // Chosen when the table is created.
+    bool robinHood;
+    double maxLoad;
+    KeyArena arena;         // Characters and hashes of every key.
+    // Table being drained into `table`, or nullptr when no resize is running.
+    // Its slots stay untouched until it is freed, so probing it stays valid.
+    KeyRef *oldTable;
+    int *oldDist;
+    int oldSize;
+    int migrateIndex;       // Next bucket of oldTable to move.
+};
+
+// Probe-length statistics over every key in a table.
+// histogram[d] counts the keys a search finds after d+1 slot inspections.
+struct ProbeStats {
+    int *histogram;
+    int maxProbe;           // Longest successful search, in slots inspected.
+    double averageProbe;
+    int keys;
+};
+
+// Allocate a bucket array and its probe-distance array, all slots empty.
+// Both are released with free.
+inline void allocateBuckets(int size, KeyRef **table, int **dist) {
+    *table = (KeyRef *)calloc(size, sizeof(KeyRef));
+    *dist = (int *)calloc(size, sizeof(int));
+    if (*table == nullptr || *dist == nullptr) {
+        free(*table);
+        free(*dist);
+        throw std::bad_alloc();
+    }
+}
+
+// Create and initialize a hash table with at least the given number of buckets.
+inline HashTable* createHashTable(int size, bool robinHood = false,
+                           HashFunction hash = polynomialHash) {
+    int capacity = 1;
+    while (capacity < size) {
+        capacity *= 2;
+    }
+
+    HashTable* ht = new HashTable;
+    ht->size = capacity;
+    ht->count = 0;
+    ht->hash = hash;
+    ht->robinHood = robinHood;
+    ht->maxLoad = robinHood ? ROBIN_HOOD_MAX_LOAD : MAX_LOAD;
+    allocateBuckets(capacity, &ht->table, &ht->dist);
+    initArena(&ht->arena);
+    ht->oldTable = nullptr;
+    ht->oldDist = nullptr;
+    ht->oldSize = 0;
+    ht->migrateIndex = 0;
+    return ht;
+}
+
+// Quadratic probe for key in one bucket array; returns its index or -1.
+inline int findIndex(const KeyRef *table, const int *dist, int size, bool robinHood,
+              const KeyArena *arena, const std::string &key, ull hash_val) {
+    int index = hash_val & (size - 1);
+
+    // Try indices hash + 0, +1, +3, +6, ... (hash + i(i+1)/2) mod table_size.
+    for (int i = 0; i < size; i++) {
+        // If an empty slot is found, the key is not in the table.
+        if (isEmpty(table[index])) {
+            return -1;
+        }
+        // A Robin Hood insert would have displaced a key this close to home.
+        if (robinHood && dist[index] < i) {
+            return -1;
+        }
+        if (keyEquals(arena, table[index], key, hash_val)) {
+            return index;
+        }
+        index = (index + i + 1) & (size - 1);
+    }
+    return -1;
+}
+
+// Put a stored key into its probe sequence.
+// The caller guarantees the key is absent and that a free slot exists.
+inline void placeKey(KeyRef *table, int *dist, int size, bool robinHood, KeyRef key, ull hash_val) {
+    int index = hash_val & (size - 1);
+    int i = 0;
+    while (!isEmpty(table[index])) {
+        if (robinHood && dist[index] < i) {
+            // Take the slot and keep probing for the evicted key from where it was.
+            KeyRef evicted = table[index];
+            int evictedDist = dist[index];
+            table[index] = key;
+            dist[index] = i;
+            key = evicted;
+            i = evictedDist;
+        }
+        i++;
+        index = (index + i) & (size - 1);
+    }
+    table[index] = key;
+    dist[index] = i;
+}
+
+// Move up to REHASH_STEP buckets of the old table into the current one,
+// releasing the old bucket array once the last bucket has been moved.
+inline void migrateStep(HashTable* ht) {
+    if (ht->oldTable == nullptr) {
+        return;
+    }
+    for (int moved = 0; moved < REHASH_STEP && ht->migrateIndex < ht->oldSize; moved++) {
+        KeyRef key = ht->oldTable[ht->migrateIndex++];
+        if (!isEmpty(key)) {
+            placeKey(ht->table, ht->dist, ht->size, ht->robinHood, key, arenaHash(&ht->arena, key));
+        }
+    }
+    if (ht->migrateIndex == ht->oldSize) {
+        free(ht->oldTable);
+        free(ht->oldDist);
+        ht->oldTable = nullptr;
+        ht->oldDist = nullptr;
+        ht->oldSize = 0;
+        ht->migrateIndex = 0;
+    }
+}
+
+// Start moving the keys into a table of twice the size.
+// The move itself is spread over the following operations by migrateStep.
+inline void beginResize(HashTable* ht) {
+    // A resize drains faster than the new table can fill up, but finish any
+    // straggler so there is never more than one old table.
+    while (ht->oldTable != nullptr) {
+        migrateStep(ht);
+    }
+    ht->oldTable = ht->table;
+    ht->oldDist = ht->dist;
+    ht->oldSize = ht->size;
+    ht->migrateIndex = 0;
+    ht->size = 2 * ht->size;
+    allocateBuckets(ht->size, &ht->table, &ht->dist);
+}
+
+// Returns true if key is stored in either the current or the old table.
+inline bool contains(HashTable* ht, const std::string &key, ull hash_val) {
+    if (findIndex(ht->table, ht->dist, ht->size, ht->robinHood, &ht->arena, key, hash_val) != -1) {
+        return true;
+    }
+    // Keys not yet moved are still reachable through the old table.
+    return ht->oldTable != nullptr &&
+           findIndex(ht->oldTable, ht->oldDist, ht->oldSize, ht->robinHood, &ht->arena, key, hash_val) != -1;
+}
+
+// Insert a key into the hash table using quadratic probing.
+// Returns true if insertion is successful, or false if the key already exists
+// or is longer than MAX_KEY_LENGTH.
+inline bool insert(HashTable* ht, const std::string &key) {
+    if (key.size() > MAX_KEY_LENGTH) {
+        return false;
+    }
+    migrateStep(ht);
+    ull hash_val = ht->hash(key);
+
+    // If the key is already present, do not insert it again.
+    if (contains(ht, key, hash_val)) {
+        return false;
+    }
+
+    if (ht->count + 1 > ht->maxLoad * ht->size) {
+        beginResize(ht);
+    }
+
+    KeyRef stored = arenaAppend(&ht->arena, key.data(), key.size(), hash_val);
+    placeKey(ht->table, ht->dist, ht->size, ht->robinHood, stored, hash_val);
+    ht->count++;
+    return true;
+}
+
+// Search for a key in the hash table using quadratic probing.
+// Returns true if the key is found; otherwise, false.
+inline bool search(HashTable* ht, const std::string &key) {
+    migrateStep(ht);
+    return contains(ht, key, ht->hash(key));
+}
+
+// Number of lookups searchBatch keeps in flight at once.
+const int BATCH_WINDOW = 16;
+
+// Look up n keys at once; found[i] is set to whether keys[i] is present.
+// Keys are handled BATCH_WINDOW at a time: first every hash is computed and
+// its home slot prefetched, then the arena records those slots refer to, and
+// only then is each probe resolved, so the cache misses of a whole window
+// overlap instead of being paid one after another.
+inline void searchBatch(HashTable* ht, const std::string *keys, int n, bool *found) {
+    ull hashes[BATCH_WINDOW];
+    for (int base = 0; base < n; base += BATCH_WINDOW) {
+        int count = std::min(BATCH_WINDOW, n - base);
+        // The same migration work that count calls to search() would do.
+        for (int i = 0; i < count; i++) {
+            migrateStep(ht);
+        }
+
+        for (int i = 0; i < count; i++) {
+            hashes[i] = ht->hash(keys[base + i]);
+            int index = hashes[i] & (ht->size - 1);
+            __builtin_prefetch(&ht->table[index]);
+            if (ht->robinHood) {
+                __builtin_prefetch(&ht->dist[index]);
+            }
+            if (ht->oldTable != nullptr) {
+                __builtin_prefetch(&ht->oldTable[hashes[i] & (ht->oldSize - 1)]);
+            }
+        }
+        for (int i = 0; i < count; i++) {
+            KeyRef slot = ht->table[hashes[i] & (ht->size - 1)];
+            if (!isEmpty(slot)) {
+                __builtin_prefetch(arenaRecord(&ht->arena, slot));
+            }
+        }
+
+        for (int i = 0; i < count; i++) {
+            found[base + i] = contains(ht, keys[base + i], hashes[i]);
+        }
+    }
+}
+
+// Collect the probe-length histogram and maximum over every stored key.
+// Keys still waiting in the old table are counted where they sit now.
+inline ProbeStats* getProbeStats(HashTable* ht) {
+    ProbeStats* stats = new ProbeStats;
+    stats->maxProbe = 0;
+    stats->keys = 0;
+    long long total = 0;
+
+    // First pass finds the histogram length, second pass fills it.
+    for (int pass = 0; pass < 2; pass++) {
+        for (int t = 0; t < 2; t++) {
+            const KeyRef *table = (t == 0) ? ht->table : ht->oldTable;
+            int *dist = (t == 0) ? ht->dist : ht->oldDist;
+            int size = (t == 0) ? ht->size : ht->oldSize;
+            // Slots below migrateIndex were already copied into the new table.
+            int first = (t == 0) ? 0 : ht->migrateIndex;
+            for (int i = first; table != nullptr && i < size; i++) {
+                if (isEmpty(table[i])) {
+                    continue;
+                }
+                int probe = dist[i] + 1;
+                if (pass == 0) {
+                    if (probe > stats->maxProbe) {
+                        stats->maxProbe = probe;
+                    }
+                } else {
+                    stats->histogram[probe - 1]++;
+                    total += probe;
+                    stats->keys++;
+                }
+            }
+        }
+        if (pass == 0) {
+            stats->histogram = new int[stats->maxProbe + 1];
+            for (int d = 0; d <= stats->maxProbe; d++) {
+                stats->histogram[d] = 0;
+            }
+        }
+    }
+    stats->averageProbe = stats->keys == 0 ? 0.0 : (double)total / stats->keys;
+    return stats;
+}
+
+inline void deleteProbeStats(ProbeStats* stats) {
+    delete[] stats->histogram;
+    delete stats;
+}
+
+// Free all dynamically allocated memory for the hash table.
+// Every key lives in the arena, so they are all released by one free.
+inline void deleteHashTable(HashTable* ht) {
+    free(ht->oldTable);
+    free(ht->oldDist);
+    free(ht->table);
+    free(ht->dist);
+    freeArena(&ht->arena);
+    delete ht;
+}
+
+}  // namespace quadratic
+
+#endif
\ No newline at end of file
@@ -1,4 +1,25 @@
 #include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <utility>
+#include <cstddef>
+#include <cstdlib>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <climits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 using namespace std;
 
 // Insertion Sort
@@ -43,83 +64,1377 @@ void selectionSort(int arr[], int n) {
     }
 }
 
-// Merge function for Merge Sort
-void merge(int arr[], int left, int mid, int right) {
-    int n1 = mid - left + 1;  // Size of left subarray
-    int n2 = right - mid;     // Size of right subarray
+// ---------------- Sorting networks ----------------
+//
+// Leaf sort and merge kernels for int with the default ordering, where the
+// engines below would otherwise fall back to branchy insertion sort and
+// scalar merging. A block of up to NETWORK_SORT_THRESHOLD ints is padded
+// with INT_MAX to a whole number of vector registers (one register is 8
+// ints with AVX2, 16 with AVX-512) and sorted there by a bitonic network:
+// each register is sorted in place by a fixed sequence of min/max steps
+// against a shuffled copy of itself, then pairs, quads and octets of
+// sorted registers are merged by reversing the second half and running
+// the bitonic merge across and then within registers. No step depends on
+// the data, so there is nothing to mispredict. The same merge step, one
+// register at a time, merges two long sorted runs.
+//
+// Without AVX2 networkSort declines and the engines use insertion sort.
+
+const int NETWORK_SORT_THRESHOLD = 64;
 
-    // Dynamically allocate temporary arrays
-    int* leftArr = new int[n1];
-    int* rightArr = new int[n2];
+// Sort [first, last) with a sorting network if one exists for this element
+// type and comparator. Returns false, leaving the range alone, otherwise.
+template <typename T, typename Compare>
+inline bool networkSort(T *, T *, Compare) {
+    return false;
+}
+
+// Whether networkSort sorts ranges of this type and comparator.
+template <typename T, typename Compare>
+constexpr bool hasNetworkSort() {
+    return false;
+}
+
+#if defined(__AVX2__)
+
+#if defined(__AVX512F__)
+typedef __m512i SortVec;
+const int SORT_LANES = 16;
+
+inline SortVec loadVec(const int *p) { return _mm512_loadu_si512(p); }
+inline void storeVec(int *p, SortVec v) { _mm512_storeu_si512(p, v); }
+inline SortVec minVec(SortVec a, SortVec b) { return _mm512_min_epi32(a, b); }
+inline SortVec maxVec(SortVec a, SortVec b) { return _mm512_max_epi32(a, b); }
+
+inline SortVec reverseVec(SortVec v) {
+    return _mm512_permutexvar_epi32(_mm512_setr_epi32(15, 14, 13, 12, 11, 10, 9, 8,
+                                                      7, 6, 5, 4, 3, 2, 1, 0), v);
+}
 
-    // Copy data into temporary arrays
-    for (int i = 0; i < n1; i++) {
-        leftArr[i] = arr[left + i];
+// v with each lane i exchanged with lane i ^ D.
+template <int D>
+inline SortVec partnerVec(SortVec v) {
+    if (D == 1) {
+        return _mm512_shuffle_epi32(v, _MM_PERM_CDAB);
+    } else if (D == 2) {
+        return _mm512_shuffle_epi32(v, _MM_PERM_BADC);
+    } else if (D == 4) {
+        return _mm512_shuffle_i32x4(v, v, _MM_SHUFFLE(2, 3, 0, 1));
     }
-    for (int j = 0; j < n2; j++) {
-        rightArr[j] = arr[mid + 1 + j];
+    return _mm512_shuffle_i32x4(v, v, _MM_SHUFFLE(1, 0, 3, 2));
+}
+
+// Lanes of lo where MASK is clear, lanes of hi where it is set.
+template <int MASK>
+inline SortVec blendVec(SortVec lo, SortVec hi) {
+    return _mm512_mask_blend_epi32((__mmask16)MASK, lo, hi);
+}
+#else
+typedef __m256i SortVec;
+const int SORT_LANES = 8;
+
+inline SortVec loadVec(const int *p) { return _mm256_loadu_si256((const __m256i *)p); }
+inline void storeVec(int *p, SortVec v) { _mm256_storeu_si256((__m256i *)p, v); }
+inline SortVec minVec(SortVec a, SortVec b) { return _mm256_min_epi32(a, b); }
+inline SortVec maxVec(SortVec a, SortVec b) { return _mm256_max_epi32(a, b); }
+
+inline SortVec reverseVec(SortVec v) {
+    return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+// v with each lane i exchanged with lane i ^ D.
+template <int D>
+inline SortVec partnerVec(SortVec v) {
+    if (D == 1) {
+        return _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+    } else if (D == 2) {
+        return _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
     }
+    return _mm256_permute2x128_si256(v, v, 1);
+}
+
+// Lanes of lo where MASK is clear, lanes of hi where it is set.
+template <int MASK>
+inline SortVec blendVec(SortVec lo, SortVec hi) {
+    return _mm256_blend_epi32(lo, hi, MASK);
+}
+#endif
 
-    // Merge the temporary arrays back into arr[left...right]
-    int i = 0, j = 0, k = left;
-    while (i < n1 && j < n2) {
-        if (leftArr[i] <= rightArr[j])
-            arr[k++] = leftArr[i++];
-        else
-            arr[k++] = rightArr[j++];
+// Lanes that keep the larger value in the step of distance d of the
+// bitonic sort stage that builds sorted runs of k lanes: the upper lane of
+// each pair, except in runs that are being sorted descending.
+constexpr int stageMask(int k, int d) {
+    int mask = 0;
+    for (int i = 0; i < SORT_LANES; i++) {
+        if (((i & d) != 0) != ((i & k) != 0)) {
+            mask |= 1 << i;
+        }
     }
-    // Copy any remaining elements of leftArr
-    while (i < n1)
-        arr[k++] = leftArr[i++];
-    // Copy any remaining elements of rightArr
-    while (j < n2)
-        arr[k++] = rightArr[j++];
+    return mask;
+}
 
-    // Free the dynamically allocated memory
-    delete[] leftArr;
-    delete[] rightArr;
+template <int K, int D>
+inline SortVec compareExchange(SortVec v) {
+    SortVec p = partnerVec<D>(v);
+    return blendVec<stageMask(K, D)>(minVec(v, p), maxVec(v, p));
 }
 
-// Merge Sort
-void mergeSort(int arr[], int left, int right) {
-    if (left < right) {
-        int mid = left + (right - left) / 2;
-        mergeSort(arr, left, mid);
-        mergeSort(arr, mid + 1, right);
-        merge(arr, left, mid, right);
+// Sort a register holding a bitonic sequence.
+inline SortVec bitonicCleanup(SortVec v) {
+#if defined(__AVX512F__)
+    v = compareExchange<16, 8>(v);
+#endif
+    v = compareExchange<16, 4>(v);
+    v = compareExchange<16, 2>(v);
+    return compareExchange<16, 1>(v);
+}
+
+// Sort the lanes of one register.
+inline SortVec sortVec(SortVec v) {
+    v = compareExchange<2, 1>(v);
+    v = compareExchange<4, 2>(v);
+    v = compareExchange<4, 1>(v);
+#if defined(__AVX512F__)
+    v = compareExchange<8, 4>(v);
+    v = compareExchange<8, 2>(v);
+    v = compareExchange<8, 1>(v);
+#endif
+    return bitonicCleanup(v);
+}
+
+// Given two sorted registers, leave the smaller half of their lanes in lo
+// and the larger half in hi, each sorted.
+inline void mergeVecPair(SortVec &lo, SortVec &hi) {
+    SortVec reversed = reverseVec(hi);
+    SortVec small = minVec(lo, reversed), large = maxVec(lo, reversed);
+    lo = bitonicCleanup(small);
+    hi = bitonicCleanup(large);
+}
+
+// Merge registers v[0..count/2) and v[count/2..count), each sorted as a
+// whole, into one sorted sequence of count registers.
+inline void mergeRegisterHalves(SortVec *v, int count) {
+    int half = count / 2;
+    for (int i = 0; i < half / 2; i++) {
+        std::swap(v[half + i], v[count - 1 - i]);
+    }
+    for (int i = half; i < count; i++) {
+        v[i] = reverseVec(v[i]);
+    }
+    for (int d = half; d >= 1; d /= 2) {
+        for (int i = 0; i < count; i++) {
+            if ((i & d) == 0) {
+                SortVec a = v[i];
+                v[i] = minVec(a, v[i + d]);
+                v[i + d] = maxVec(a, v[i + d]);
+            }
+        }
+    }
+    for (int i = 0; i < count; i++) {
+        v[i] = bitonicCleanup(v[i]);
+    }
+}
+
+// Sort n <= NETWORK_SORT_THRESHOLD ints in registers.
+inline void sortSmallBlock(int *a, ptrdiff_t n) {
+    const int MAX_REGISTERS = NETWORK_SORT_THRESHOLD / SORT_LANES;
+    alignas(64) int block[NETWORK_SORT_THRESHOLD];
+    int registers = 1;
+    while (registers * SORT_LANES < n) {
+        registers *= 2;
+    }
+    std::copy(a, a + n, block);
+    std::fill(block + n, block + registers * SORT_LANES, INT_MAX);
+
+    SortVec v[MAX_REGISTERS];
+    for (int i = 0; i < registers; i++) {
+        v[i] = sortVec(loadVec(block + i * SORT_LANES));
     }
+    for (int width = 2; width <= registers; width *= 2) {
+        for (int base = 0; base < registers; base += width) {
+            mergeRegisterHalves(v + base, width);
+        }
+    }
+    for (int i = 0; i < registers; i++) {
+        storeVec(block + i * SORT_LANES, v[i]);
+    }
+    std::copy(block, block + n, a);
 }
 
-// Partition function for Quick Sort
-int partition(int arr[], int left, int right) {
-    int pivot = arr[right];  // Choose the last element as pivot
-    int i = left - 1;
-    for (int j = left; j < right; j++) {
-        if (arr[j] < pivot) {
-            i++;
-            // Swap arr[i] and arr[j]
-            int temp = arr[i];
-            arr[i] = arr[j];
-            arr[j] = temp;
+inline bool networkSort(int *first, int *last, std::less<int>) {
+    sortSmallBlock(first, last - first);
+    return true;
+}
+
+template <>
+constexpr bool hasNetworkSort<int, std::less<int> >() {
+    return true;
+}
+
+// Merge the sorted ranges [a, aEnd) and [b, bEnd) into out one register
+// at a time: the register that holds the larger half of the last merge
+// step is merged with the next register of whichever input has the smaller
+// head, and the smaller half is written out. What remains once either
+// input runs short of a register is merged element by element.
+inline void mergeRuns(int *a, int *aEnd, int *b, int *bEnd, int *out, std::less<int>) {
+    if (a != aEnd && b != bEnd && *b >= *(aEnd - 1)) {
+        out = std::copy(a, aEnd, out);
+        std::copy(b, bEnd, out);
+        return;
+    }
+    alignas(64) int carry[SORT_LANES];
+    int *c = carry, *cEnd = carry;
+    if (aEnd - a >= SORT_LANES && bEnd - b >= SORT_LANES) {
+        SortVec lo = loadVec(a), hi = loadVec(b);
+        a += SORT_LANES;
+        b += SORT_LANES;
+        mergeVecPair(lo, hi);
+        storeVec(out, lo);
+        out += SORT_LANES;
+        while (aEnd - a >= SORT_LANES && bEnd - b >= SORT_LANES) {
+            if (*a <= *b) {
+                lo = loadVec(a);
+                a += SORT_LANES;
+            } else {
+                lo = loadVec(b);
+                b += SORT_LANES;
+            }
+            mergeVecPair(lo, hi);
+            storeVec(out, lo);
+            out += SORT_LANES;
+        }
+        storeVec(carry, hi);
+        cEnd = carry + SORT_LANES;
+    }
+
+    // Three-way merge of the carried register and both tails.
+    while (c != cEnd || a != aEnd || b != bEnd) {
+        int *next = nullptr;
+        if (c != cEnd) {
+            next = c;
+        }
+        if (a != aEnd && (next == nullptr || *a < *next)) {
+            next = a;
+        }
+        if (b != bEnd && (next == nullptr || *b < *next)) {
+            next = b;
+        }
+        *out++ = *next;
+        if (next == c) {
+            c++;
+        } else if (next == a) {
+            a++;
+        } else {
+            b++;
         }
     }
-    // Swap arr[i+1] and arr[right] (pivot)
-    int temp = arr[i + 1];
-    arr[i + 1] = arr[right];
-    arr[right] = temp;
-    return i + 1;
 }
 
-// Quick Sort
+#endif
+
+// ---------------- Introsort engine ----------------
+//
+// Pattern-defeating quicksort (after Orson Peters' pdqsort), generic over the
+// element type and comparator. Ranges are half-open [first, last).
+//  - Pivots are the median of three, or Tukey's ninther (median of three
+//    medians) above NINTHER_THRESHOLD elements, so sorted, reversed and
+//    organ-pipe inputs partition evenly instead of degrading to O(n^2).
+//  - For arithmetic types the partition is branchless: comparisons are
+//    recorded as offsets into small blocks and the misplaced elements are
+//    swapped afterwards, so the hot loop has no unpredictable branches.
+//  - Ranges below INSERTION_SORT_THRESHOLD are finished by insertion sort,
+//    or ranges of up to NETWORK_SORT_THRESHOLD by a sorting network where
+//    networkSort has one.
+//  - A partition that leaves less than 1/8 of the range on one side counts
+//    as bad; it shuffles a few elements to break up whatever pattern caused
+//    it, and after log2(n) bad partitions the range is heapsorted, which
+//    bounds the worst case at O(n log n).
+//  - A partition that moved nothing hints at sorted input; both sides are
+//    then tried with an insertion sort that gives up after a few moves.
+//  - Runs of elements equal to an earlier pivot are split off in one pass.
+// Only the left side of each partition is recursed into and the right side
+// is looped on; both shrink geometrically except after a bad partition, so
+// the stack stays O(log n) deep.
+
+const int INSERTION_SORT_THRESHOLD = 24;
+const int NINTHER_THRESHOLD = 128;
+const int PARTIAL_INSERTION_SORT_LIMIT = 8;
+const int PARTITION_BLOCK = 64;
+
+// Insertion sort of [first, last).
+template <typename T, typename Compare>
+void insertionSortRange(T *first, T *last, Compare comp) {
+    if (first == last) {
+        return;
+    }
+    for (T *cur = first + 1; cur != last; cur++) {
+        if (comp(*cur, *(cur - 1))) {
+            T key = std::move(*cur);
+            T *hole = cur;
+            do {
+                *hole = std::move(*(hole - 1));
+                hole--;
+            } while (hole != first && comp(key, *(hole - 1)));
+            *hole = std::move(key);
+        }
+    }
+}
+
+// Insertion sort of [first, last) where *(first - 1) is no greater than any
+// element of the range, so the inner loop needs no bounds check.
+template <typename T, typename Compare>
+void unguardedInsertionSort(T *first, T *last, Compare comp) {
+    if (first == last) {
+        return;
+    }
+    for (T *cur = first + 1; cur != last; cur++) {
+        if (comp(*cur, *(cur - 1))) {
+            T key = std::move(*cur);
+            T *hole = cur;
+            do {
+                *hole = std::move(*(hole - 1));
+                hole--;
+            } while (comp(key, *(hole - 1)));
+            *hole = std::move(key);
+        }
+    }
+}
+
+// Insertion sort that gives up once it has moved more than
+// PARTIAL_INSERTION_SORT_LIMIT elements. Returns true if the range is sorted.
+template <typename T, typename Compare>
+bool partialInsertionSort(T *first, T *last, Compare comp) {
+    if (first == last) {
+        return true;
+    }
+    ptrdiff_t moved = 0;
+    for (T *cur = first + 1; cur != last; cur++) {
+        if (comp(*cur, *(cur - 1))) {
+            T key = std::move(*cur);
+            T *hole = cur;
+            do {
+                *hole = std::move(*(hole - 1));
+                hole--;
+            } while (hole != first && comp(key, *(hole - 1)));
+            *hole = std::move(key);
+            moved += cur - hole;
+        }
+        if (moved > PARTIAL_INSERTION_SORT_LIMIT) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Restore the max-heap property below heap[root] in a heap of n elements.
+template <typename T, typename Compare>
+void siftDown(T *heap, ptrdiff_t n, ptrdiff_t root, Compare comp) {
+    T value = std::move(heap[root]);
+    ptrdiff_t child;
+    while ((child = 2 * root + 1) < n) {
+        if (child + 1 < n && comp(heap[child], heap[child + 1])) {
+            child++;
+        }
+        if (!comp(value, heap[child])) {
+            break;
+        }
+        heap[root] = std::move(heap[child]);
+        root = child;
+    }
+    heap[root] = std::move(value);
+}
+
+// Heapsort of [first, last): the O(n log n) fallback.
+template <typename T, typename Compare>
+void heapSortRange(T *first, T *last, Compare comp) {
+    ptrdiff_t n = last - first;
+    for (ptrdiff_t i = n / 2 - 1; i >= 0; i--) {
+        siftDown(first, n, i, comp);
+    }
+    for (ptrdiff_t end = n - 1; end > 0; end--) {
+        std::swap(first[0], first[end]);
+        siftDown(first, end, 0, comp);
+    }
+}
+
+template <typename T, typename Compare>
+inline void sort2(T *a, T *b, Compare comp) {
+    if (comp(*b, *a)) {
+        std::swap(*a, *b);
+    }
+}
+
+// Sort *a, *b, *c in place.
+template <typename T, typename Compare>
+inline void sort3(T *a, T *b, T *c, Compare comp) {
+    sort2(a, b, comp);
+    sort2(b, c, comp);
+    sort2(a, b, comp);
+}
+
+// Partition [first, last) around the pivot *first: elements less than the
+// pivot end up before it, the rest after. Requires an element no less than
+// the pivot somewhere after first, which pivot selection guarantees.
+// Returns the pivot's final position and whether the range was already
+// partitioned (nothing had to be swapped).
+template <typename T, typename Compare>
+std::pair<T *, bool> partitionRight(T *first, T *last, Compare comp) {
+    T pivot = std::move(*first);
+    T *l = first, *r = last;
+    while (comp(*++l, pivot)) {
+    }
+    if (l - 1 == first) {
+        while (l < r && !comp(*--r, pivot)) {
+        }
+    } else {
+        while (!comp(*--r, pivot)) {
+        }
+    }
+    bool alreadyPartitioned = l >= r;
+    while (l < r) {
+        std::swap(*l, *r);
+        while (comp(*++l, pivot)) {
+        }
+        while (!comp(*--r, pivot)) {
+        }
+    }
+    T *pivotPos = l - 1;
+    *first = std::move(*pivotPos);
+    *pivotPos = std::move(pivot);
+    return std::make_pair(pivotPos, alreadyPartitioned);
+}
+
+// Swap num pairs of misplaced elements found by partitionRightBranchless,
+// given as offsets forward from l and backward from r. When the two blocks
+// hold different counts the swaps are done as one cyclic rotation, which
+// needs fewer moves.
+template <typename T>
+inline void swapOffsets(T *l, T *r, const unsigned char *offsetsL, const unsigned char *offsetsR,
+                        size_t num, bool useSwaps) {
+    if (useSwaps) {
+        for (size_t i = 0; i < num; i++) {
+            std::swap(*(l + offsetsL[i]), *(r - offsetsR[i]));
+        }
+    } else if (num > 0) {
+        T *a = l + offsetsL[0];
+        T *b = r - offsetsR[0];
+        T tmp = std::move(*a);
+        *a = std::move(*b);
+        for (size_t i = 1; i < num; i++) {
+            a = l + offsetsL[i];
+            *b = std::move(*a);
+            b = r - offsetsR[i];
+            *a = std::move(*b);
+        }
+        *b = std::move(tmp);
+    }
+}
+
+// Same contract as partitionRight, using block partitioning (Edelkamp and
+// Weiss). Up to PARTITION_BLOCK elements from each end are compared first,
+// storing the offsets of those on the wrong side without branching on the
+// result; then the two offset lists are swapped pairwise.
+template <typename T, typename Compare>
+std::pair<T *, bool> partitionRightBranchless(T *first, T *last, Compare comp) {
+    T pivot = std::move(*first);
+    T *l = first, *r = last;
+    while (comp(*++l, pivot)) {
+    }
+    if (l - 1 == first) {
+        while (l < r && !comp(*--r, pivot)) {
+        }
+    } else {
+        while (!comp(*--r, pivot)) {
+        }
+    }
+    bool alreadyPartitioned = l >= r;
+    if (!alreadyPartitioned) {
+        std::swap(*l, *r);
+        l++;
+
+        unsigned char offsetsL[PARTITION_BLOCK], offsetsR[PARTITION_BLOCK];
+        T *baseL = l, *baseR = r;
+        size_t numL = 0, numR = 0, startL = 0, startR = 0;
+        while (l < r) {
+            // Refill whichever block is empty; when both are and fewer than
+            // two blocks' worth of elements remain, split them between the two.
+            size_t unknown = r - l;
+            size_t splitL = numL == 0 ? (numR == 0 ? unknown / 2 : unknown) : 0;
+            size_t splitR = numR == 0 ? unknown - splitL : 0;
+            splitL = std::min<size_t>(splitL, PARTITION_BLOCK);
+            splitR = std::min<size_t>(splitR, PARTITION_BLOCK);
+            for (size_t i = 0; i < splitL; i++) {
+                offsetsL[numL] = i;
+                numL += !comp(*l, pivot);
+                l++;
+            }
+            for (size_t i = 0; i < splitR; ) {
+                offsetsR[numR] = ++i;
+                numR += comp(*--r, pivot);
+            }
+
+            size_t num = std::min(numL, numR);
+            swapOffsets(baseL, baseR, offsetsL + startL, offsetsR + startR, num, numL == numR);
+            numL -= num;
+            numR -= num;
+            startL += num;
+            startR += num;
+            if (numL == 0) {
+                startL = 0;
+                baseL = l;
+            }
+            if (numR == 0) {
+                startR = 0;
+                baseR = r;
+            }
+        }
+
+        // One block may still hold misplaced elements; move them across the
+        // boundary, which is where the pivot goes.
+        if (numL != 0) {
+            while (numL-- > 0) {
+                std::swap(*(baseL + offsetsL[startL + numL]), *--r);
+            }
+            l = r;
+        }
+        if (numR != 0) {
+            while (numR-- > 0) {
+                std::swap(*(baseR - offsetsR[startR + numR]), *l);
+                l++;
+            }
+        }
+    }
+    T *pivotPos = l - 1;
+    *first = std::move(*pivotPos);
+    *pivotPos = std::move(pivot);
+    return std::make_pair(pivotPos, alreadyPartitioned);
+}
+
+// Partition [first, last) around *first with elements equal to the pivot
+// on the left, and return the pivot's final position. Used when the pivot
+// equals the element just before the range: everything left of the
+// returned position is then equal to it and needs no more sorting.
+template <typename T, typename Compare>
+T *partitionLeft(T *first, T *last, Compare comp) {
+    T pivot = std::move(*first);
+    T *l = first, *r = last;
+    while (comp(pivot, *--r)) {
+    }
+    if (r + 1 == last) {
+        while (l < r && !comp(pivot, *++l)) {
+        }
+    } else {
+        while (!comp(pivot, *++l)) {
+        }
+    }
+    while (l < r) {
+        std::swap(*l, *r);
+        while (comp(pivot, *--r)) {
+        }
+        while (!comp(pivot, *++l)) {
+        }
+    }
+    *first = std::move(*r);
+    *r = std::move(pivot);
+    return r;
+}
+
+// Sort [first, last). badAllowed is the number of bad partitions left before
+// switching to heapsort; leftmost is false when *(first - 1) is known to be
+// no greater than anything in the range.
+template <typename T, typename Compare, bool Branchless>
+void introSortLoop(T *first, T *last, Compare comp, int badAllowed, bool leftmost) {
+    while (true) {
+        ptrdiff_t size = last - first;
+        if (size <= NETWORK_SORT_THRESHOLD && networkSort(first, last, comp)) {
+            return;
+        }
+        if (size < INSERTION_SORT_THRESHOLD) {
+            if (leftmost) {
+                insertionSortRange(first, last, comp);
+            } else {
+                unguardedInsertionSort(first, last, comp);
+            }
+            return;
+        }
+
+        // Move the chosen pivot to *first; *(last - 1) ends up no less than it.
+        ptrdiff_t half = size / 2;
+        if (size > NINTHER_THRESHOLD) {
+            sort3(first, first + half, last - 1, comp);
+            sort3(first + 1, first + (half - 1), last - 2, comp);
+            sort3(first + 2, first + (half + 1), last - 3, comp);
+            sort3(first + (half - 1), first + half, first + (half + 1), comp);
+            std::swap(*first, *(first + half));
+        } else {
+            sort3(first + half, first, last - 1, comp);
+        }
+
+        // The pivot equals an earlier pivot: split off the run equal to it.
+        if (!leftmost && !comp(*(first - 1), *first)) {
+            first = partitionLeft(first, last, comp) + 1;
+            continue;
+        }
+
+        std::pair<T *, bool> part = Branchless ? partitionRightBranchless(first, last, comp)
+                                               : partitionRight(first, last, comp);
+        T *pivotPos = part.first;
+        ptrdiff_t leftSize = pivotPos - first;
+        ptrdiff_t rightSize = last - (pivotPos + 1);
+
+        if (leftSize < size / 8 || rightSize < size / 8) {
+            if (--badAllowed == 0) {
+                heapSortRange(first, last, comp);
+                return;
+            }
+            // Swap a few elements from the middle of each side to its ends
+            // so the next pivot choice sees a different sample.
+            if (leftSize >= INSERTION_SORT_THRESHOLD) {
+                std::swap(*first, *(first + leftSize / 4));
+                std::swap(*(pivotPos - 1), *(pivotPos - leftSize / 4));
+                if (leftSize > NINTHER_THRESHOLD) {
+                    std::swap(*(first + 1), *(first + (leftSize / 4 + 1)));
+                    std::swap(*(first + 2), *(first + (leftSize / 4 + 2)));
+                    std::swap(*(pivotPos - 2), *(pivotPos - (leftSize / 4 + 1)));
+                    std::swap(*(pivotPos - 3), *(pivotPos - (leftSize / 4 + 2)));
+                }
+            }
+            if (rightSize >= INSERTION_SORT_THRESHOLD) {
+                std::swap(*(pivotPos + 1), *(pivotPos + (1 + rightSize / 4)));
+                std::swap(*(last - 1), *(last - rightSize / 4));
+                if (rightSize > NINTHER_THRESHOLD) {
+                    std::swap(*(pivotPos + 2), *(pivotPos + (2 + rightSize / 4)));
+                    std::swap(*(pivotPos + 3), *(pivotPos + (3 + rightSize / 4)));
+                    std::swap(*(last - 2), *(last - (1 + rightSize / 4)));
+                    std::swap(*(last - 3), *(last - (2 + rightSize / 4)));
+                }
+            }
+        } else if (part.second && partialInsertionSort(first, pivotPos, comp) &&
+                   partialInsertionSort(pivotPos + 1, last, comp)) {
+            return;  // Looked sorted, and was.
+        }
+
+        introSortLoop<T, Compare, Branchless>(first, pivotPos, comp, badAllowed, leftmost);
+        first = pivotPos + 1;
+        leftmost = false;
+    }
+}
+
+// Sort [first, last) by comp. Not stable.
+template <typename T, typename Compare>
+void introSort(T *first, T *last, Compare comp) {
+    if (last - first < 2) {
+        return;
+    }
+    int log2n = 0;
+    for (ptrdiff_t n = last - first; n > 1; n >>= 1) {
+        log2n++;
+    }
+    introSortLoop<T, Compare, std::is_arithmetic<T>::value>(first, last, comp, log2n, true);
+}
+
+template <typename T>
+void introSort(T *first, T *last) {
+    introSort(first, last, std::less<T>());
+}
+
+// Quick Sort: sorts arr[left..right] with the introsort engine above.
 void quickSort(int arr[], int left, int right) {
     if (left < right) {
-        int pivotIndex = partition(arr, left, right);
-        quickSort(arr, left, pivotIndex - 1);
-        quickSort(arr, pivotIndex + 1, right);
+        introSort(arr + left, arr + right + 1);
+    }
+}
+
+// ---------------- Merge sort engine ----------------
+//
+// Bottom-up, stable merge sort, generic over the element type and
+// comparator. Runs of MERGE_RUN elements are first put in order by
+// insertion sort (runs of NETWORK_SORT_THRESHOLD by a sorting network where
+// networkSort has one, which for int also means merging a register at a
+// time); then passes of doubling width merge neighbouring runs
+// from one array into the other and back again (ping-pong), so the only
+// allocation is one scratch buffer of n elements for the whole sort, and
+// none at all if the caller passes one in. There is no recursion.
+
+const int MERGE_RUN = 32;
+
+// Stably merge the sorted ranges [a, aEnd) and [b, bEnd) into out. On ties
+// the element of the first range comes first.
+template <typename T, typename Compare>
+void mergeRuns(T *a, T *aEnd, T *b, T *bEnd, T *out, Compare comp) {
+    if (a != aEnd && b != bEnd && !comp(*b, *(aEnd - 1))) {
+        // Already in order: a plain move.
+        out = std::move(a, aEnd, out);
+        std::move(b, bEnd, out);
+        return;
+    }
+    while (a != aEnd && b != bEnd) {
+        if (comp(*b, *a)) {
+            *out++ = std::move(*b++);
+        } else {
+            *out++ = std::move(*a++);
+        }
+    }
+    out = std::move(a, aEnd, out);
+    std::move(b, bEnd, out);
+}
+
+// Stable sort of [first, last) using buffer, which must have room for
+// last - first elements, as scratch space.
+template <typename T, typename Compare>
+void mergeSortWithBuffer(T *first, T *last, T *buffer, Compare comp) {
+    ptrdiff_t n = last - first;
+    const ptrdiff_t run = hasNetworkSort<T, Compare>() ? NETWORK_SORT_THRESHOLD : MERGE_RUN;
+    for (ptrdiff_t lo = 0; lo < n; lo += run) {
+        T *runEnd = first + std::min(lo + run, n);
+        if (!networkSort(first + lo, runEnd, comp)) {
+            insertionSortRange(first + lo, runEnd, comp);
+        }
+    }
+
+    T *src = first, *dst = buffer;
+    for (ptrdiff_t width = run; width < n; width *= 2) {
+        for (ptrdiff_t lo = 0; lo < n; lo += 2 * width) {
+            ptrdiff_t mid = std::min(lo + width, n);
+            ptrdiff_t hi = std::min(lo + 2 * width, n);
+            mergeRuns(src + lo, src + mid, src + mid, src + hi, dst + lo, comp);
+        }
+        std::swap(src, dst);
+    }
+    if (src != first) {
+        std::move(src, src + n, first);
+    }
+}
+
+// Stable sort of [first, last) by comp.
+template <typename T, typename Compare>
+void mergeSortRange(T *first, T *last, Compare comp) {
+    if (last - first <= MERGE_RUN) {
+        if (!networkSort(first, last, comp)) {
+            insertionSortRange(first, last, comp);
+        }
+        return;
+    }
+    T *buffer = new T[last - first];
+    mergeSortWithBuffer(first, last, buffer, comp);
+    delete[] buffer;
+}
+
+template <typename T>
+void mergeSortRange(T *first, T *last) {
+    mergeSortRange(first, last, std::less<T>());
+}
+
+// Merge Sort: sorts arr[left..right] with the merge sort engine above.
+void mergeSort(int arr[], int left, int right) {
+    if (left < right) {
+        mergeSortRange(arr + left, arr + right + 1);
+    }
+}
+
+// ---------------- Parallel merge sort ----------------
+//
+// Fork-join parallel version of the merge sort engine for very large
+// arrays. Tasks run on a work-stealing pool: every thread pushes the tasks
+// it forks onto the back of its own queue and takes work from there first
+// (newest first, which keeps the working set in its cache), and a thread
+// that runs dry steals the oldest task of another queue, which is the
+// largest piece of work available. A thread waiting for its forked tasks
+// keeps running tasks instead of blocking, so the pool cannot deadlock
+// however deep the recursion gets.
+//
+// The sort splits in half down to PARALLEL_SORT_CUTOFF elements, which go
+// to the sequential engine. Merges are parallel too: the output is cut
+// into pieces of PARALLEL_MERGE_CHUNK elements, and the point where each
+// piece starts in the two inputs is found by binary search along the
+// merge path (co-ranking), so every piece merges independently. Halves
+// ping-pong between the array and one scratch buffer as in the sequential
+// engine. The result is stable.
+
+const ptrdiff_t PARALLEL_SORT_CUTOFF = 1 << 14;
+const ptrdiff_t PARALLEL_MERGE_CHUNK = 1 << 14;
+
+struct Task {
+    void (*run)(void *arg);
+    void *arg;
+    std::atomic<int> *pending;      // Decremented when the task has run.
+};
+
+struct WorkerQueue {
+    std::mutex lock;
+    std::deque<Task> tasks;
+};
+
+struct ThreadPool {
+    std::vector<WorkerQueue *> queues;  // One per thread; 0 is the thread that sorts.
+    std::vector<std::thread> threads;
+    std::atomic<int> queued;            // Tasks waiting in all queues.
+    std::atomic<bool> stop;
+    std::mutex idleLock;                // Guards sleeping on `wake`.
+    std::condition_variable wake;
+};
+
+// Queue of the calling thread in the pool it works for, or -1.
+thread_local int workerIndex = -1;
+
+// Take one task, from our own queue's back or else from the front of
+// another queue, and run it. Returns false if every queue was empty.
+bool runOneTask(ThreadPool* pool) {
+    int me = workerIndex;
+    int count = pool->queues.size();
+    Task task;
+    bool found = false;
+    for (int k = 0; k < count && !found; k++) {
+        WorkerQueue *queue = pool->queues[(me + k) % count];
+        std::lock_guard<std::mutex> guard(queue->lock);
+        if (!queue->tasks.empty()) {
+            if (k == 0) {
+                task = queue->tasks.back();
+                queue->tasks.pop_back();
+            } else {
+                task = queue->tasks.front();
+                queue->tasks.pop_front();
+            }
+            found = true;
+        }
+    }
+    if (!found) {
+        return false;
+    }
+    pool->queued--;
+    task.run(task.arg);
+    task.pending->fetch_sub(1);
+    return true;
+}
+
+void workerLoop(ThreadPool* pool, int index) {
+    workerIndex = index;
+    while (!pool->stop) {
+        if (!runOneTask(pool)) {
+            std::unique_lock<std::mutex> guard(pool->idleLock);
+            pool->wake.wait(guard, [pool] { return pool->stop || pool->queued > 0; });
+        }
+    }
+}
+
+// A pool of `threads` threads, counting the one that will call
+// parallelMergeSort; only threads - 1 are started.
+ThreadPool* createThreadPool(int threads) {
+    ThreadPool* pool = new ThreadPool;
+    pool->queued = 0;
+    pool->stop = false;
+    for (int i = 0; i < std::max(1, threads); i++) {
+        pool->queues.push_back(new WorkerQueue);
+    }
+    for (int i = 1; i < (int)pool->queues.size(); i++) {
+        pool->threads.emplace_back(workerLoop, pool, i);
+    }
+    return pool;
+}
+
+void deleteThreadPool(ThreadPool* pool) {
+    {
+        std::lock_guard<std::mutex> guard(pool->idleLock);
+        pool->stop = true;
+    }
+    pool->wake.notify_all();
+    for (std::thread &thread : pool->threads) {
+        thread.join();
     }
+    for (WorkerQueue *queue : pool->queues) {
+        delete queue;
+    }
+    delete pool;
+}
+
+// Queue run(arg) on the calling thread's queue. *pending must have been
+// counted up for it; it is counted down once the task has run.
+void spawnTask(ThreadPool* pool, void (*run)(void *), void *arg, std::atomic<int> *pending) {
+    WorkerQueue *queue = pool->queues[workerIndex];
+    {
+        std::lock_guard<std::mutex> guard(queue->lock);
+        queue->tasks.push_back(Task{run, arg, pending});
+    }
+    {
+        std::lock_guard<std::mutex> guard(pool->idleLock);
+        pool->queued++;
+    }
+    pool->wake.notify_one();
 }
 
-int main() {
+// Run queued tasks until *pending drops to zero.
+void waitForTasks(ThreadPool* pool, std::atomic<int> *pending) {
+    while (pending->load() > 0) {
+        if (!runOneTask(pool)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+// Number of elements of a that come among the first d elements of the
+// stable merge of a[0..na) and b[0..nb) (elements of a win ties).
+template <typename T, typename Compare>
+ptrdiff_t coRank(ptrdiff_t d, const T *a, ptrdiff_t na, const T *b, ptrdiff_t nb, Compare comp) {
+    ptrdiff_t lo = std::max<ptrdiff_t>(0, d - nb), hi = std::min(d, na);
+    while (lo < hi) {
+        ptrdiff_t i = lo + (hi - lo) / 2;
+        // a[i] is among the first d unless b[d - i - 1] sorts strictly before it.
+        if (!comp(b[d - i - 1], a[i])) {
+            lo = i + 1;
+        } else {
+            hi = i;
+        }
+    }
+    return lo;
+}
+
+template <typename T, typename Compare>
+struct MergeChunk {
+    T *a, *b, *out;
+    ptrdiff_t na, nb, begin, end;   // Output range [begin, end) of this piece.
+    Compare comp;
+};
+
+template <typename T, typename Compare>
+void runMergeChunk(void *arg) {
+    MergeChunk<T, Compare> *chunk = (MergeChunk<T, Compare> *)arg;
+    ptrdiff_t i0 = coRank(chunk->begin, chunk->a, chunk->na, chunk->b, chunk->nb, chunk->comp);
+    ptrdiff_t i1 = coRank(chunk->end, chunk->a, chunk->na, chunk->b, chunk->nb, chunk->comp);
+    ptrdiff_t j0 = chunk->begin - i0, j1 = chunk->end - i1;
+    mergeRuns(chunk->a + i0, chunk->a + i1, chunk->b + j0, chunk->b + j1, chunk->out + chunk->begin,
+              chunk->comp);
+}
+
+// Stably merge a[0..na) and b[0..nb) into out, PARALLEL_MERGE_CHUNK
+// output elements per task.
+template <typename T, typename Compare>
+void parallelMerge(ThreadPool* pool, T *a, ptrdiff_t na, T *b, ptrdiff_t nb, T *out, Compare comp) {
+    ptrdiff_t n = na + nb;
+    ptrdiff_t pieces = (n + PARALLEL_MERGE_CHUNK - 1) / PARALLEL_MERGE_CHUNK;
+    std::vector<MergeChunk<T, Compare> > chunks;
+    chunks.reserve(pieces);  // Tasks point into it; it must not move.
+    std::atomic<int> pending(pieces - 1);
+    for (ptrdiff_t p = 0; p < pieces; p++) {
+        chunks.push_back(MergeChunk<T, Compare>{a, b, out, na, nb, p * PARALLEL_MERGE_CHUNK,
+                                                std::min(n, (p + 1) * PARALLEL_MERGE_CHUNK), comp});
+        if (p > 0) {
+            spawnTask(pool, runMergeChunk<T, Compare>, &chunks[p], &pending);
+        }
+    }
+    runMergeChunk<T, Compare>(&chunks[0]);
+    waitForTasks(pool, &pending);
+}
+
+template <typename T, typename Compare>
+struct SortJob {
+    ThreadPool* pool;
+    T *src, *dst;       // The elements, and scratch space of the same size.
+    ptrdiff_t n;
+    bool intoDst;       // Leave the sorted result in dst rather than src.
+    Compare comp;
+};
+
+template <typename T, typename Compare>
+void runSortJob(void *arg) {
+    SortJob<T, Compare> *job = (SortJob<T, Compare> *)arg;
+    T *src = job->src, *dst = job->dst;
+    ptrdiff_t n = job->n;
+    if (n <= PARALLEL_SORT_CUTOFF) {
+        mergeSortWithBuffer(src, src + n, dst, job->comp);
+        if (job->intoDst) {
+            std::move(src, src + n, dst);
+        }
+        return;
+    }
+
+    // Sort both halves into the array we are not merging into, the first
+    // as a task and the second ourselves, then merge them across.
+    ptrdiff_t half = n / 2;
+    SortJob<T, Compare> left = {job->pool, src, dst, half, !job->intoDst, job->comp};
+    SortJob<T, Compare> right = {job->pool, src + half, dst + half, n - half, !job->intoDst, job->comp};
+    std::atomic<int> pending(1);
+    spawnTask(job->pool, runSortJob<T, Compare>, &left, &pending);
+    runSortJob<T, Compare>(&right);
+    waitForTasks(job->pool, &pending);
+
+    T *from = job->intoDst ? src : dst;
+    T *to = job->intoDst ? dst : src;
+    parallelMerge(job->pool, from, half, from + half, n - half, to, job->comp);
+}
+
+// Stable sort of [first, last) on the threads of pool. Must be called from
+// a thread that does not belong to any pool, and by one caller at a time.
+template <typename T, typename Compare>
+void parallelMergeSortRange(ThreadPool* pool, T *first, T *last, Compare comp) {
+    if (last - first <= PARALLEL_SORT_CUTOFF || pool->queues.size() == 1) {
+        mergeSortRange(first, last, comp);
+        return;
+    }
+    T *buffer = new T[last - first];
+    workerIndex = 0;
+    SortJob<T, Compare> job = {pool, first, buffer, last - first, false, comp};
+    runSortJob<T, Compare>(&job);
+    workerIndex = -1;
+    delete[] buffer;
+}
+
+// Parallel Merge Sort: sorts arr[0..n) with `threads` threads.
+void parallelMergeSort(int arr[], ptrdiff_t n, int threads) {
+    ThreadPool* pool = createThreadPool(threads);
+    parallelMergeSortRange(pool, arr, arr + n, std::less<int>());
+    deleteThreadPool(pool);
+}
+
+// ---------------- Radix sorts ----------------
+//
+// Integer keys (any width, signed or unsigned) sorted by their bits instead
+// of by comparisons, optionally carrying a payload array along: values[i]
+// moves wherever keys[i] goes. Signed keys are sorted by their unsigned
+// image with the sign bit flipped, which orders them the same way.
+//
+// lsdRadixSort is stable and needs a buffer as large as the input. It
+// sorts RADIX_BITS-bit digits from the least significant up (3 passes for
+// 32-bit keys, 6 for 64-bit ones), ping-ponging between the input and the
+// buffer. The histograms of every digit are counted in one read of the
+// keys before the first pass, and a pass whose digit is the same for
+// every key is skipped outright, so small keys in wide types cost only
+// the passes their bits need.
+//
+// americanFlagSort is in place but not stable: an MSD radix sort on 8-bit
+// digits that permutes each bucket into position by following cycles, then
+// recurses into each bucket on the next digit. Buckets of up to
+// FLAG_INSERTION_THRESHOLD elements are finished by insertion sort.
+
+const int RADIX_BITS = 11;
+const int RADIX_BUCKETS = 1 << RADIX_BITS;
+const int FLAG_INSERTION_THRESHOLD = 32;
+
+// Unsigned image of key whose order matches the order of the keys.
+template <typename K>
+inline typename std::make_unsigned<K>::type radixImage(K key) {
+    typedef typename std::make_unsigned<K>::type U;
+    const U signBit = std::is_signed<K>::value ? (U)1 << (sizeof(K) * 8 - 1) : 0;
+    return (U)key ^ signBit;
+}
+
+// Sort keys[0..n) and, unless values is null, carry values[0..n) along.
+// keyBuffer and valueBuffer (null if values is) must hold n elements.
+template <typename K, typename V>
+void lsdRadixSort(K *keys, V *values, ptrdiff_t n, K *keyBuffer, V *valueBuffer) {
+    typedef typename std::make_unsigned<K>::type U;
+    const int passes = (sizeof(K) * 8 + RADIX_BITS - 1) / RADIX_BITS;
+    if (n < 2) {
+        return;
+    }
+
+    std::vector<ptrdiff_t> counts(passes * RADIX_BUCKETS, 0);
+    for (ptrdiff_t i = 0; i < n; i++) {
+        U image = radixImage(keys[i]);
+        for (int p = 0; p < passes; p++) {
+            counts[p * RADIX_BUCKETS + ((image >> (p * RADIX_BITS)) & (RADIX_BUCKETS - 1))]++;
+        }
+    }
+
+    K *src = keys, *dst = keyBuffer;
+    V *valueSrc = values, *valueDst = valueBuffer;
+    for (int p = 0; p < passes; p++) {
+        int shift = p * RADIX_BITS;
+        ptrdiff_t *offset = &counts[p * RADIX_BUCKETS];
+        if (offset[(radixImage(src[0]) >> shift) & (RADIX_BUCKETS - 1)] == n) {
+            continue;  // Every key has the same digit here.
+        }
+        ptrdiff_t sum = 0;
+        for (int d = 0; d < RADIX_BUCKETS; d++) {
+            ptrdiff_t count = offset[d];
+            offset[d] = sum;
+            sum += count;
+        }
+        for (ptrdiff_t i = 0; i < n; i++) {
+            ptrdiff_t to = offset[(radixImage(src[i]) >> shift) & (RADIX_BUCKETS - 1)]++;
+            dst[to] = src[i];
+            if (values != nullptr) {
+                valueDst[to] = valueSrc[i];
+            }
+        }
+        std::swap(src, dst);
+        std::swap(valueSrc, valueDst);
+    }
+    if (src != keys) {
+        std::copy(src, src + n, keys);
+        if (values != nullptr) {
+            std::copy(valueSrc, valueSrc + n, values);
+        }
+    }
+}
+
+// Insertion sort of keys[0..n), carrying values along unless it is null.
+template <typename K, typename V>
+void insertionSortPairs(K *keys, V *values, ptrdiff_t n) {
+    for (ptrdiff_t i = 1; i < n; i++) {
+        K key = keys[i];
+        ptrdiff_t j = i - 1;
+        if (values == nullptr) {
+            while (j >= 0 && key < keys[j]) {
+                keys[j + 1] = keys[j];
+                j--;
+            }
+        } else {
+            V value = values[i];
+            while (j >= 0 && key < keys[j]) {
+                keys[j + 1] = keys[j];
+                values[j + 1] = values[j];
+                j--;
+            }
+            values[j + 1] = value;
+        }
+        keys[j + 1] = key;
+    }
+}
+
+// Sort keys[0..n), all of which agree on the bits above shift + 8, by the
+// 8-bit digit at shift and then recursively by the lower digits.
+template <typename K, typename V>
+void americanFlagPass(K *keys, V *values, ptrdiff_t n, int shift) {
+    if (n <= FLAG_INSERTION_THRESHOLD) {
+        insertionSortPairs(keys, values, n);
+        return;
+    }
+    ptrdiff_t count[256] = {0};
+    for (ptrdiff_t i = 0; i < n; i++) {
+        count[(radixImage(keys[i]) >> shift) & 0xFF]++;
+    }
+    ptrdiff_t start[256], next[256];
+    ptrdiff_t sum = 0;
+    for (int d = 0; d < 256; d++) {
+        start[d] = next[d] = sum;
+        sum += count[d];
+    }
+
+    // Walk each bucket's unfilled part; every key found there is swapped
+    // into the next free place of its own bucket until one that belongs
+    // here turns up.
+    for (int b = 0; b < 256; b++) {
+        ptrdiff_t end = start[b] + count[b];
+        while (next[b] < end) {
+            K key = keys[next[b]];
+            V value = values != nullptr ? values[next[b]] : V();
+            int d = (radixImage(key) >> shift) & 0xFF;
+            while (d != b) {
+                ptrdiff_t to = next[d]++;
+                std::swap(key, keys[to]);
+                if (values != nullptr) {
+                    std::swap(value, values[to]);
+                }
+                d = (radixImage(key) >> shift) & 0xFF;
+            }
+            keys[next[b]] = key;
+            if (values != nullptr) {
+                values[next[b]] = value;
+            }
+            next[b]++;
+        }
+    }
+
+    if (shift == 0) {
+        return;
+    }
+    for (int d = 0; d < 256; d++) {
+        if (count[d] > 1) {
+            americanFlagPass(keys + start[d], values != nullptr ? values + start[d] : nullptr,
+                             count[d], shift - 8);
+        }
+    }
+}
+
+// In-place sort of keys[0..n), carrying values along unless it is null.
+template <typename K, typename V>
+void americanFlagSort(K *keys, V *values, ptrdiff_t n) {
+    americanFlagPass(keys, values, n, (int)sizeof(K) * 8 - 8);
+}
+
+// Radix Sort: sorts arr[0..n) with the LSD radix sort.
+void radixSort(int arr[], int n) {
+    int *buffer = new int[n];
+    lsdRadixSort(arr, (int *)nullptr, n, buffer, (int *)nullptr);
+    delete[] buffer;
+}
+
+// American Flag Sort: sorts arr[0..n) in place with the MSD radix sort.
+void americanFlagSort(int arr[], int n) {
+    americanFlagSort(arr, (int *)nullptr, n);
+}
+
+// ---------------- Benchmark ----------------
+
+// Input shapes the benchmark sorts. Sorted and reversed input used to send
+// the old last-element-pivot quickSort quadratic and overflow the stack.
+const char *const INPUT_KINDS[] = {"random", "sorted", "reversed", "organ", "few"};
+const int INPUT_KIND_COUNT = 5;
+
+void fillInput(int arr[], int n, int kind, mt19937 &rng) {
+    for (int i = 0; i < n; i++) {
+        switch (kind) {
+            case 0: arr[i] = rng(); break;
+            case 1: arr[i] = i; break;
+            case 2: arr[i] = n - i; break;
+            case 3: arr[i] = i < n / 2 ? i : n - i; break;
+            default: arr[i] = rng() % 16; break;
+        }
+    }
+}
+
+struct SortRoutine {
+    const char *name;
+    void (*sort)(int arr[], int n);
+};
+
+void runQuickSort(int arr[], int n) {
+    quickSort(arr, 0, n - 1);
+}
+
+void runMergeSort(int arr[], int n) {
+    mergeSort(arr, 0, n - 1);
+}
+
+void runParallelMergeSort(int arr[], int n) {
+    parallelMergeSort(arr, n, std::max(1u, std::thread::hardware_concurrency()));
+}
+
+void runRadixSort(int arr[], int n) {
+    radixSort(arr, n);
+}
+
+void runAmericanFlagSort(int arr[], int n) {
+    americanFlagSort(arr, n);
+}
+
+void runStdSort(int arr[], int n) {
+    std::sort(arr, arr + n);
+}
+
+void runStdStableSort(int arr[], int n) {
+    std::stable_sort(arr, arr + n);
+}
+
+// Time every routine on every input shape with n elements and check that
+// each result is sorted. Prints nanoseconds per element.
+void runSortBenchmark(int n) {
+    const SortRoutine routines[] = {
+        {"quickSort", runQuickSort},
+        {"std::sort", runStdSort},
+        {"mergeSort", runMergeSort},
+        {"std::stable_sort", runStdStableSort},
+        {"parallelMergeSort", runParallelMergeSort},
+        {"radixSort", runRadixSort},
+        {"americanFlagSort", runAmericanFlagSort},
+    };
+    mt19937 rng(12345);
+    std::vector<int> input(n), work(n);
+
+    cout << "n = " << n << ", ns per element" << endl << "routine";
+    for (int kind = 0; kind < INPUT_KIND_COUNT; kind++) {
+        cout << "\t" << INPUT_KINDS[kind];
+    }
+    cout << endl;
+    for (const SortRoutine &routine : routines) {
+        cout << routine.name;
+        for (int kind = 0; kind < INPUT_KIND_COUNT; kind++) {
+            fillInput(input.data(), n, kind, rng);
+            work = input;
+            auto start = chrono::steady_clock::now();
+            routine.sort(work.data(), n);
+            auto stop = chrono::steady_clock::now();
+            std::sort(input.begin(), input.end());
+            cout << "\t" << (work == input ? "" : "WRONG ")
+                 << chrono::duration<double, nano>(stop - start).count() / n;
+        }
+        cout << endl;
+    }
+}
+
+// Sort the same n random elements with 1, 2, 4, ... threads, up to twice
+// the number of cores, and report the speedup over one thread.
+void runScalingBenchmark(ptrdiff_t n) {
+    mt19937 rng(12345);
+    std::vector<int> input(n), work(n);
+    for (ptrdiff_t i = 0; i < n; i++) {
+        input[i] = rng();
+    }
+    int cores = std::max(1u, std::thread::hardware_concurrency());
+    double single = 0;
+    cout << "n = " << n << ", " << cores << " cores" << endl << "threads\ts\tspeedup" << endl;
+    for (int threads = 1; threads <= 2 * cores; threads *= 2) {
+        work = input;
+        ThreadPool* pool = createThreadPool(threads);
+        auto start = chrono::steady_clock::now();
+        parallelMergeSortRange(pool, work.data(), work.data() + n, std::less<int>());
+        auto stop = chrono::steady_clock::now();
+        deleteThreadPool(pool);
+        double seconds = chrono::duration<double>(stop - start).count();
+        if (threads == 1) {
+            single = seconds;
+        }
+        cout << threads << "\t" << seconds << "\t" << single / seconds
+             << (std::is_sorted(work.begin(), work.end()) ? "" : "\tWRONG") << endl;
+    }
+}
+
+// Sort many random blocks of 8, 16, 32 and 64 ints one at a time, by
+// insertion sort and by the sorting network, and print ns per element.
+void runLeafBenchmark() {
+    const int TOTAL = 1 << 22;
+    mt19937 rng(12345);
+    std::vector<int> input(TOTAL), work(TOTAL);
+    for (int i = 0; i < TOTAL; i++) {
+        input[i] = rng();
+    }
+    cout << "block\tinsertion\tnetwork" << endl;
+    for (int block = 8; block <= NETWORK_SORT_THRESHOLD; block *= 2) {
+        cout << block;
+        for (int pass = 0; pass < 2; pass++) {
+            work = input;
+            auto start = chrono::steady_clock::now();
+            bool ran = true;
+            for (int i = 0; i < TOTAL && ran; i += block) {
+                if (pass == 0) {
+                    insertionSortRange(&work[i], &work[i] + block, std::less<int>());
+                } else {
+                    ran = networkSort(&work[i], &work[i] + block, std::less<int>());
+                }
+            }
+            auto stop = chrono::steady_clock::now();
+            cout << "\t";
+            if (!ran) {
+                cout << "-";
+                continue;
+            }
+            bool sorted = true;
+            for (int i = 0; i < TOTAL; i += block) {
+                sorted = sorted && std::is_sorted(&work[i], &work[i] + block);
+            }
+            cout << (sorted ? "" : "WRONG ") << chrono::duration<double, nano>(stop - start).count() / TOTAL;
+        }
+        cout << endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // "bench N" times the sorts on N elements of several input shapes.
+    if (argc > 2 && string(argv[1]) == "bench") {
+        runSortBenchmark(atoi(argv[2]));
+        return 0;
+    }
+    // "leaf" compares the small-block sorts.
+    if (argc > 1 && string(argv[1]) == "leaf") {
+        runLeafBenchmark();
+        return 0;
+    }
+    // "scale N" times the parallel merge sort of N elements per thread count.
+    if (argc > 2 && string(argv[1]) == "scale") {
+        runScalingBenchmark(atoll(argv[2]));
+        return 0;
+    }
+
     int n;
     cout << "Enter the number of elements: ";
     cin >> n;
@@ -0,0 +1,185 @@
+#ifndef STRING_HASH_H
+#define STRING_HASH_H
+
+#include <string>
+#include <cstring>
+#include "hash_functions.h"
+
+// Chained hash table of strings. The demo program is string_hash.cpp;
+// concurrent_hash.cpp shards several of these tables across threads and
+// hash_table_bench.cpp compares it with the other tables.
+
+namespace chained {
+
+// Keys up to this many bytes are stored inside the node itself.
+const int INLINE_KEY_SIZE = 15;
+
+// Number of nodes carved out of each slab allocation.
+const int SLAB_NODES = 1024;
+
+// Node structure for linked list chaining in each bucket.
+// The key's hash is kept next to the link so that a chain walk rejects
+// almost every non-matching node with one integer compare, without
+// touching the key bytes. Short keys live inline; longer keys get their
+// own heap buffer.
+struct Node {
+    unsigned long long hash;
+    Node* next;
+    unsigned int length;
+    union {
+        char inlineKey[INLINE_KEY_SIZE + 1];
+        char* heapKey;
+    };
+};
+
+// Nodes are handed out from fixed-size slabs instead of one `new` per key,
+// so neighbouring chain nodes tend to share cache lines.
+struct NodeSlab {
+    Node nodes[SLAB_NODES];
+    NodeSlab* next;
+};
+
+// Hash table structure with an array of pointers to Node (one per bucket).
+struct HashTable {
+    Node** buckets;
+    int size;
+    HashFunction hash; // Chosen when the table is created.
+    NodeSlab* slabs;   // Most recent slab first.
+    int slabUsed;      // Nodes handed out from the most recent slab.
+};
+
+// Create a hash table with a specified number of buckets.
+inline HashTable* createHashTable(int size, HashFunction hash = polynomialHash) {
+    HashTable* ht = new HashTable;
+    ht->size = size;
+    ht->hash = hash;
+    ht->buckets = new Node*[size];
+    for (int i = 0; i < size; i++) {
+        ht->buckets[i] = nullptr;
+    }
+    ht->slabs = nullptr;
+    ht->slabUsed = 0;
+    return ht;
+}
+
+// Take the next free node from the current slab, starting a new slab when full.
+inline Node* allocateNode(HashTable* ht) {
+    if (ht->slabs == nullptr || ht->slabUsed == SLAB_NODES) {
+        NodeSlab* slab = new NodeSlab;
+        slab->next = ht->slabs;
+        ht->slabs = slab;
+        ht->slabUsed = 0;
+    }
+    return &ht->slabs->nodes[ht->slabUsed++];
+}
+
+// Returns a pointer to the key bytes of a node, wherever they are stored.
+inline const char* nodeKey(const Node* node) {
+    return node->length <= INLINE_KEY_SIZE ? node->inlineKey : node->heapKey;
+}
+
+// Allocate and fill a node for key; the caller links it into a chain.
+inline Node* makeNode(HashTable* ht, const std::string &key, unsigned long long hash_val) {
+    Node* newNode = allocateNode(ht);
+    newNode->hash = hash_val;
+    newNode->length = key.size();
+    if (key.size() <= INLINE_KEY_SIZE) {
+        memcpy(newNode->inlineKey, key.data(), key.size());
+    } else {
+        newNode->heapKey = new char[key.size()];
+        memcpy(newNode->heapKey, key.data(), key.size());
+    }
+    newNode->next = nullptr;
+    return newNode;
+}
+
+// Returns true if node holds key (whose hash is hash_val).
+// The cached hash and length filter out mismatches before any key bytes are compared.
+inline bool nodeMatches(const Node* node, const std::string &key, unsigned long long hash_val) {
+    return node->hash == hash_val && node->length == key.size() &&
+           memcmp(nodeKey(node), key.data(), key.size()) == 0;
+}
+
+// Insert a key (std::string) into the hash table using chaining.
+inline void insert(HashTable* ht, const std::string &key) {
+    unsigned long long hash_val = ht->hash(key);
+    int index = hash_val % ht->size;
+
+    // Create a new node with the key and insert it at the beginning of the chain.
+    Node* newNode = makeNode(ht, key, hash_val);
+    newNode->next = ht->buckets[index];
+    ht->buckets[index] = newNode;
+}
+
+// Search for a key in the hash table; returns true if found, false otherwise.
+inline bool search(HashTable* ht, const std::string &key) {
+    unsigned long long hash_val = ht->hash(key);
+    int index = hash_val % ht->size;
+    Node* current = ht->buckets[index];
+
+    // Traverse the chain in the bucket to find the key.
+    while (current != nullptr) {
+        if (nodeMatches(current, key, hash_val)) {
+            return true;
+        }
+        current = current->next;
+    }
+    return false;
+}
+
+// Number of lookups searchBatch keeps in flight at once.
+const int BATCH_WINDOW = 16;
+
+// Look up n keys at once; found[i] is set to whether keys[i] is present.
+// Keys are handled BATCH_WINDOW at a time: first every hash is computed and
+// its bucket head prefetched, then the first node of each chain, and only
+// then are the chains walked, so the cache misses of a whole window overlap
+// instead of being paid one after another.
+inline void searchBatch(HashTable* ht, const std::string *keys, int n, bool *found) {
+    unsigned long long hashes[BATCH_WINDOW];
+    for (int base = 0; base < n; base += BATCH_WINDOW) {
+        int count = n - base < BATCH_WINDOW ? n - base : BATCH_WINDOW;
+        for (int i = 0; i < count; i++) {
+            hashes[i] = ht->hash(keys[base + i]);
+            __builtin_prefetch(&ht->buckets[hashes[i] % ht->size]);
+        }
+        for (int i = 0; i < count; i++) {
+            Node* head = ht->buckets[hashes[i] % ht->size];
+            if (head != nullptr) {
+                __builtin_prefetch(head);
+            }
+        }
+
+        for (int i = 0; i < count; i++) {
+            const std::string &key = keys[base + i];
+            Node* current = ht->buckets[hashes[i] % ht->size];
+            while (current != nullptr && !nodeMatches(current, key, hashes[i])) {
+                current = current->next;
+            }
+            found[base + i] = current != nullptr;
+        }
+    }
+}
+
+// Delete the hash table and free all allocated memory.
+inline void deleteHashTable(HashTable* ht) {
+    // Only long keys own a buffer; the nodes themselves go away with their slabs.
+    for (int i = 0; i < ht->size; i++) {
+        for (Node* current = ht->buckets[i]; current != nullptr; current = current->next) {
+            if (current->length > INLINE_KEY_SIZE) {
+                delete[] current->heapKey;
+            }
+        }
+    }
+    while (ht->slabs != nullptr) {
+        NodeSlab* slab = ht->slabs;
+        ht->slabs = slab->next;
+        delete slab;
+    }
+    delete[] ht->buckets;
+    delete ht;
+}
+
+}  // namespace chained
+
+#endif
\ No newline at end of file
@@ -0,0 +1,568 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Suffix-array index over a fixed text. karp_rabin.cpp and aho_corasick.cpp
+// read the whole text for every search; here the text is sorted once and a
+// query is a binary search over its suffixes, so it never rescans the text.
+// The index is written to a file that is mapped at startup, so a process
+// serving queries pays nothing to load it.
+
+// ---------------- SA-IS construction ----------------
+//
+// Induced sorting (Nong, Zhang and Chan): classify each suffix as S-type
+// (smaller than the suffix after it) or L-type, sort only the leftmost
+// S-type (LMS) substrings, and induce the order of every other suffix from
+// theirs with two sweeps over the buckets. If two LMS substrings tie, the
+// LMS suffixes are sorted by recursing on the reduced string of their
+// names, which is at most half as long. Total time is O(n).
+
+// Start (end == false) or one past the end (end == true) of each symbol's
+// bucket in sa.
+void getBuckets(const int *s, int n, int K, bool end, int *bucket) {
+    std::fill(bucket, bucket + K, 0);
+    for (int i = 0; i < n; i++) {
+        bucket[s[i]]++;
+    }
+    int sum = 0;
+    for (int c = 0; c < K; c++) {
+        sum += bucket[c];
+        bucket[c] = end ? sum : sum - bucket[c];
+    }
+}
+
+// Given the LMS suffixes placed at the ends of their buckets, fill in the
+// L-type suffixes left to right and then the S-type ones right to left.
+void induceSort(const int *s, const std::vector<bool> &stype, int *sa, int n, int K, int *bucket) {
+    getBuckets(s, n, K, false, bucket);
+    for (int i = 0; i < n; i++) {
+        int j = sa[i] - 1;
+        if (sa[i] > 0 && !stype[j]) {
+            sa[bucket[s[j]]++] = j;
+        }
+    }
+    getBuckets(s, n, K, true, bucket);
+    for (int i = n - 1; i >= 0; i--) {
+        int j = sa[i] - 1;
+        if (sa[i] > 0 && stype[j]) {
+            sa[--bucket[s[j]]] = j;
+        }
+    }
+}
+
+// Sort the suffixes of s[0..n), whose symbols are in [0, K) and whose last
+// symbol is a unique 0, into sa.
+void sais(const int *s, int *sa, int n, int K) {
+    std::vector<bool> stype(n);
+    stype[n - 1] = true;
+    for (int i = n - 2; i >= 0; i--) {
+        stype[i] = s[i] < s[i + 1] || (s[i] == s[i + 1] && stype[i + 1]);
+    }
+    auto isLMS = [&](int i) { return i > 0 && stype[i] && !stype[i - 1]; };
+
+    // Sort the LMS substrings.
+    std::vector<int> bucket(K);
+    getBuckets(s, n, K, true, bucket.data());
+    std::fill(sa, sa + n, -1);
+    for (int i = 1; i < n; i++) {
+        if (isLMS(i)) {
+            sa[--bucket[s[i]]] = i;
+        }
+    }
+    induceSort(s, stype, sa, n, K, bucket.data());
+
+    // Move the sorted LMS substrings to the front of sa and name them;
+    // equal substrings get equal names.
+    int n1 = 0;
+    for (int i = 0; i < n; i++) {
+        if (isLMS(sa[i])) {
+            sa[n1++] = sa[i];
+        }
+    }
+    std::fill(sa + n1, sa + n, -1);
+    int names = 0, prev = -1;
+    for (int i = 0; i < n1; i++) {
+        int pos = sa[i];
+        bool differ = prev == -1;
+        for (int d = 0; !differ; d++) {
+            if (s[pos + d] != s[prev + d] || stype[pos + d] != stype[prev + d]) {
+                differ = true;
+            } else if (d > 0 && (isLMS(pos + d) || isLMS(prev + d))) {
+                break;
+            }
+        }
+        if (differ) {
+            names++;
+            prev = pos;
+        }
+        sa[n1 + pos / 2] = names - 1;  // LMS positions are at least 2 apart.
+    }
+    int *s1 = sa + n - n1;             // Reduced string, in text order.
+    for (int i = n - 1, j = n - 1; i >= n1; i--) {
+        if (sa[i] >= 0) {
+            sa[j--] = sa[i];
+        }
+    }
+
+    // Sort the LMS suffixes: directly if every name is unique, otherwise by
+    // sorting the suffixes of the reduced string.
+    int *sa1 = sa;
+    if (names < n1) {
+        sais(s1, sa1, n1, names);
+    } else {
+        for (int i = 0; i < n1; i++) {
+            sa1[s1[i]] = i;
+        }
+    }
+
+    // Put the LMS suffixes in their final order at their buckets' ends and
+    // induce everything else from them.
+    for (int i = 1, j = 0; i < n; i++) {
+        if (isLMS(i)) {
+            s1[j++] = i;
+        }
+    }
+    for (int i = 0; i < n1; i++) {
+        sa1[i] = s1[sa1[i]];
+    }
+    std::fill(sa + n1, sa + n, -1);
+    getBuckets(s, n, K, true, bucket.data());
+    for (int i = n1 - 1; i >= 0; i--) {
+        int j = sa[i];
+        sa[i] = -1;
+        sa[--bucket[s[j]]] = j;
+    }
+    induceSort(s, stype, sa, n, K, bucket.data());
+}
+
+// Suffix array of text[0..n): sa[i] is the start of the i-th smallest
+// suffix. Requires n < INT_MAX.
+std::vector<int> buildSuffixArray(const char *text, int n) {
+    if (n == 0) {
+        return std::vector<int>();
+    }
+    // Bytes become symbols 1..256 and a 0 sentinel is appended; its suffix
+    // sorts first and is dropped.
+    std::vector<int> s(n + 1);
+    for (int i = 0; i < n; i++) {
+        s[i] = (unsigned char)text[i] + 1;
+    }
+    s[n] = 0;
+    std::vector<int> sa(n + 1);
+    sais(s.data(), sa.data(), n + 1, 257);
+    sa.erase(sa.begin());
+    return sa;
+}
+
+// Kasai's algorithm: lcp[i] is the length of the longest common prefix of
+// the suffixes at sa[i - 1] and sa[i], and lcp[0] = 0. O(n).
+std::vector<int> buildLcpArray(const char *text, int n, const std::vector<int> &sa) {
+    std::vector<int> rank(n), lcp(n, 0);
+    for (int i = 0; i < n; i++) {
+        rank[sa[i]] = i;
+    }
+    int h = 0;
+    for (int i = 0; i < n; i++) {
+        if (rank[i] == 0) {
+            h = 0;
+            continue;
+        }
+        int j = sa[rank[i] - 1];
+        while (i + h < n && j + h < n && text[i + h] == text[j + h]) {
+            h++;
+        }
+        lcp[rank[i]] = h;
+        if (h > 0) {
+            h--;
+        }
+    }
+    return lcp;
+}
+
+// ---------------- Search intervals ----------------
+//
+// Queries bisect the suffix array between bounds L and R, starting from the
+// virtual bounds -1 and n, always probing M = L + (R - L) / 2. Every search
+// therefore visits intervals of one fixed binary tree, and for each M that
+// tree has exactly one interval (L, R). leftLcp[M] and rightLcp[M] hold the
+// longest common prefix of suffix M with suffix L and with suffix R of that
+// interval (0 for a virtual bound). They let a search skip the characters it
+// already knows agree (Manber and Myers), so a query of m bytes costs
+// O(m + log n) character comparisons instead of O(m log n).
+
+// Fill leftLcp and rightLcp for the subtree of interval (L, R) and return
+// the common prefix length of suffixes L and R, which is the smallest lcp
+// entry in L+1 .. R.
+int fillIntervalLcp(const std::vector<int> &lcp, int L, int R,
+                    std::vector<int> &leftLcp, std::vector<int> &rightLcp) {
+    int n = lcp.size();
+    if (R - L == 1) {
+        return (L < 0 || R >= n) ? 0 : lcp[R];
+    }
+    int M = L + (R - L) / 2;
+    leftLcp[M] = fillIntervalLcp(lcp, L, M, leftLcp, rightLcp);
+    rightLcp[M] = fillIntervalLcp(lcp, M, R, leftLcp, rightLcp);
+    return (L < 0 || R >= n) ? 0 : std::min(leftLcp[M], rightLcp[M]);
+}
+
+// ---------------- Index file ----------------
+//
+// saveIndex writes everything a query needs, so openIndex only maps the
+// file and checks its header:
+//
+//   IndexHeader                   64 bytes
+//   text                          textBytes, zero-padded to a multiple of 4
+//   int32 sa[textBytes]
+//   int32 lcp[textBytes]
+//   int32 leftLcp[textBytes]
+//   int32 rightLcp[textBytes]
+
+const char INDEX_MAGIC[8] = {'S', 'U', 'F', 'F', 'A', 'R', 'R', 'Y'};
+const uint32_t INDEX_VERSION = 1;
+
+struct IndexHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved0;
+    uint64_t textBytes;
+    char reserved[40];      // Pads the header to 64 bytes.
+};
+
+// An index opened with openIndex. All pointers point into the mapping.
+struct SuffixIndex {
+    void *base;
+    size_t bytes;
+    const char *text;
+    int n;
+    const int *sa;
+    const int *lcp;
+    const int *leftLcp;
+    const int *rightLcp;
+};
+
+inline uint64_t paddedTextBytes(uint64_t n) {
+    return (n + 3) & ~3ULL;
+}
+
+inline uint64_t indexFileBytes(uint64_t n) {
+    return sizeof(IndexHeader) + paddedTextBytes(n) + 4 * n * sizeof(int32_t);
+}
+
+// Build the index of text[0..n) and write it to path. Fails if the text is
+// too large for 32-bit suffix positions or on I/O error.
+bool saveIndex(const char *text, long long n, const char *path) {
+    if (n >= INT_MAX) {
+        return false;
+    }
+    std::vector<int> sa = buildSuffixArray(text, n);
+    std::vector<int> lcp = buildLcpArray(text, n, sa);
+    std::vector<int> leftLcp(n, 0), rightLcp(n, 0);
+    fillIntervalLcp(lcp, -1, n, leftLcp, rightLcp);
+
+    IndexHeader header = {};
+    memcpy(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    header.version = INDEX_VERSION;
+    header.textBytes = n;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write((const char *)&header, sizeof(header));
+    out.write(text, n);
+    out.write("\0\0\0", paddedTextBytes(n) - n);
+    out.write((const char *)sa.data(), n * sizeof(int));
+    out.write((const char *)lcp.data(), n * sizeof(int));
+    out.write((const char *)leftLcp.data(), n * sizeof(int));
+    out.write((const char *)rightLcp.data(), n * sizeof(int));
+    out.close();
+    return !out.fail();
+}
+
+// Map a file written by saveIndex read-only. Returns nullptr if the file
+// cannot be opened or is not a valid index.
+SuffixIndex* openIndex(const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(IndexHeader)) {
+        close(fd);
+        return nullptr;
+    }
+    size_t bytes = st.st_size;
+    void *base = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);  // The mapping stays valid after the descriptor is closed.
+    if (base == MAP_FAILED) {
+        return nullptr;
+    }
+
+    const IndexHeader *header = (const IndexHeader *)base;
+    bool valid = memcmp(header->magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) == 0 &&
+                 header->version == INDEX_VERSION &&
+                 header->textBytes < INT_MAX &&
+                 indexFileBytes(header->textBytes) == bytes;
+    if (!valid) {
+        munmap(base, bytes);
+        return nullptr;
+    }
+    // Binary searches jump around the file; don't let the kernel read ahead.
+    madvise(base, bytes, MADV_RANDOM);
+
+    SuffixIndex* index = new SuffixIndex;
+    index->base = base;
+    index->bytes = bytes;
+    index->n = header->textBytes;
+    index->text = (const char *)base + sizeof(IndexHeader);
+    index->sa = (const int *)(index->text + paddedTextBytes(index->n));
+    index->lcp = index->sa + index->n;
+    index->leftLcp = index->lcp + index->n;
+    index->rightLcp = index->leftLcp + index->n;
+    return index;
+}
+
+void closeIndex(SuffixIndex* index) {
+    munmap(index->base, index->bytes);
+    delete index;
+}
+
+// ---------------- Queries ----------------
+
+// Compare the suffix at sa[i] with the pattern, given that their first
+// `known` bytes agree. Stores their common prefix length in *common and
+// returns whether the suffix belongs before the search key. The key is the
+// pattern itself for a lower bound; for an upper bound (past == true) it is
+// the pattern followed by a byte larger than any other, so suffixes that
+// start with the pattern count as smaller too.
+inline bool suffixBefore(const SuffixIndex* index, int i, const std::string &pattern,
+                         int known, bool past, int *common) {
+    const char *suffix = index->text + index->sa[i];
+    int limit = std::min<long long>(pattern.size(), index->n - index->sa[i]);
+    int k = known;
+    while (k < limit && suffix[k] == pattern[k]) {
+        k++;
+    }
+    *common = k;
+    if (k == (int)pattern.size()) {
+        return past;
+    }
+    if (k == index->n - index->sa[i]) {
+        return true;  // The suffix is a proper prefix of the pattern.
+    }
+    return (unsigned char)suffix[k] < (unsigned char)pattern[k];
+}
+
+// First suffix-array position whose suffix does not belong before the key
+// (see suffixBefore). l and r are the common prefix lengths of the pattern
+// with the suffixes at the current bounds L and R; whichever is larger says
+// where the next comparison can start, and the interval tables say whether
+// it is needed at all.
+int searchBound(const SuffixIndex* index, const std::string &pattern, bool past) {
+    int L = -1, R = index->n;
+    int l = 0, r = 0;
+    while (R - L > 1) {
+        int M = L + (R - L) / 2;
+        int known;
+        if (l >= r) {
+            known = index->leftLcp[M];
+            if (known > l) {         // M agrees with L further than the pattern does.
+                L = M;
+                continue;
+            }
+            if (known < l) {         // M leaves L earlier than the pattern does.
+                R = M;
+                r = known;
+                continue;
+            }
+        } else {
+            known = index->rightLcp[M];
+            if (known > r) {
+                R = M;
+                continue;
+            }
+            if (known < r) {
+                L = M;
+                l = known;
+                continue;
+            }
+        }
+        int common;
+        if (suffixBefore(index, M, pattern, known, past, &common)) {
+            L = M;
+            l = common;
+        } else {
+            R = M;
+            r = common;
+        }
+    }
+    return R;
+}
+
+// Range [*first, *last) of suffix-array positions whose suffixes start with
+// pattern; its size is the number of occurrences.
+void findRange(const SuffixIndex* index, const std::string &pattern, int *first, int *last) {
+    *first = searchBound(index, pattern, false);
+    *last = searchBound(index, pattern, true);
+}
+
+// Start offsets of every occurrence of pattern, in increasing order.
+std::vector<int> findOccurrences(const SuffixIndex* index, const std::string &pattern) {
+    int first, last;
+    findRange(index, pattern, &first, &last);
+    std::vector<int> occ(index->sa + first, index->sa + last);
+    std::sort(occ.begin(), occ.end());
+    return occ;
+}
+
+// Longest substring that occurs at least twice: the largest lcp entry.
+std::string longestRepeat(const SuffixIndex* index) {
+    int best = 0;
+    for (int i = 1; i < index->n; i++) {
+        if (index->lcp[i] > index->lcp[best]) {
+            best = i;
+        }
+    }
+    if (index->n == 0) {
+        return "";
+    }
+    return std::string(index->text + index->sa[best], index->lcp[best]);
+}
+
+bool readFile(const char *path, std::string *contents) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    *contents = buffer.str();
+    return true;
+}
+
+// Read one pattern per line.
+bool readPatterns(const char *path, std::vector<std::string> *patterns) {
+    std::string patternText;
+    if (!readFile(path, &patternText)) {
+        return false;
+    }
+    std::istringstream lines(patternText);
+    std::string line;
+    while (getline(lines, line)) {
+        patterns->push_back(line);
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    // "build TEXT_FILE INDEX_FILE" sorts the suffixes of TEXT_FILE and
+    // writes the index to INDEX_FILE.
+    if (argc > 3 && string(argv[1]) == "build") {
+        std::string text;
+        if (!readFile(argv[2], &text)) {
+            cout << "Could not read " << argv[2] << endl;
+            return 1;
+        }
+        auto start = chrono::steady_clock::now();
+        bool saved = saveIndex(text.data(), text.size(), argv[3]);
+        auto stop = chrono::steady_clock::now();
+        if (!saved) {
+            cout << "Could not save index to " << argv[3] << endl;
+            return 1;
+        }
+        cout << "Indexed " << text.size() << " bytes in "
+             << chrono::duration<double>(stop - start).count() << " s" << endl;
+        return 0;
+    }
+    // "query INDEX_FILE PATTERN..." prints the number of occurrences of each
+    // PATTERN and where they start.
+    // "bench INDEX_FILE PATTERN_FILE" times one query per line of PATTERN_FILE.
+    // "repeat INDEX_FILE" prints the longest substring that occurs twice.
+    if (argc > 2 && (string(argv[1]) == "query" || string(argv[1]) == "bench" ||
+                     string(argv[1]) == "repeat")) {
+        SuffixIndex* index = openIndex(argv[2]);
+        if (index == nullptr) {
+            cout << "Could not open index file " << argv[2] << endl;
+            return 1;
+        }
+        if (string(argv[1]) == "query") {
+            for (int i = 3; i < argc; i++) {
+                std::vector<int> occ = findOccurrences(index, argv[i]);
+                cout << argv[i] << ": " << occ.size() << " occurrences";
+                for (int position : occ) {
+                    cout << " " << position;
+                }
+                cout << endl;
+            }
+        } else if (string(argv[1]) == "bench") {
+            std::vector<std::string> patterns;
+            if (argc < 4 || !readPatterns(argv[3], &patterns)) {
+                cout << "Could not read pattern file" << endl;
+                closeIndex(index);
+                return 1;
+            }
+            long long total = 0;
+            auto start = chrono::steady_clock::now();
+            for (const std::string &pattern : patterns) {
+                int first, last;
+                findRange(index, pattern, &first, &last);
+                total += last - first;
+            }
+            auto stop = chrono::steady_clock::now();
+            double seconds = chrono::duration<double>(stop - start).count();
+            cout << patterns.size() << " queries, " << total << " occurrences, "
+                 << seconds * 1e9 / std::max<size_t>(1, patterns.size()) << " ns/query" << endl;
+        } else {
+            cout << "\"" << longestRepeat(index) << "\"" << endl;
+        }
+        closeIndex(index);
+        return 0;
+    }
+
+    // Read input text and pattern
+    string text, pattern;
+    cout << "Enter text: ";
+    getline(cin, text);
+    cout << "Enter pattern: ";
+    getline(cin, pattern);
+
+    // Index the text in a temporary file and query it.
+    char path[] = "/tmp/suffix_array_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        cout << "Could not create a temporary index file." << endl;
+        return 1;
+    }
+    close(fd);
+    SuffixIndex* index = saveIndex(text.data(), text.size(), path) ? openIndex(path) : nullptr;
+    unlink(path);
+    if (index == nullptr) {
+        cout << "Could not build the index." << endl;
+        return 1;
+    }
+    std::vector<int> occ = findOccurrences(index, pattern);
+
+    // Output the results
+    if (occ.empty()) {
+        cout << "Pattern not found." << endl;
+    } else {
+        cout << "Pattern found at indices: ";
+        for (int position : occ) {
+            cout << position << " ";
+        }
+        cout << endl;
+    }
+
+    closeIndex(index);
+    return 0;
+}
\ No newline at end of file